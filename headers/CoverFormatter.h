@@ -0,0 +1,209 @@
+/*
+
+title: CoverFormatter.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef COVER_FORMATTER_H
+#define COVER_FORMATTER_H
+#include <string>
+#include <vector>
+#include <cstring>
+#include "Cube.h"
+using namespace std;
+
+typedef unsigned long long int ull;
+
+enum CoverFormat{ FORMAT_EQUATION, FORMAT_PLA, FORMAT_BLIF, FORMAT_VERILOG };
+
+bool parseFormat(const string& name, CoverFormat& format){
+    if(name == "equation") format = FORMAT_EQUATION;
+    else if(name == "pla") format = FORMAT_PLA;
+    else if(name == "blif") format = FORMAT_BLIF;
+    else if(name == "verilog") format = FORMAT_VERILOG;
+    else return false;
+    return true;
+}
+
+// Writes a cover of packed cubes as an equation ("F = ab' + c"), a Berkeley PLA, a BLIF model or a Verilog module.
+// outputs[i] has a 1 on every output cube i is written to. Input k is bit numberOfInputs - 1 - k of a cube,
+// so the first input is the most significant bit. Inputs are named a, b, c, ... by default, x0, x1, ... past 26 inputs,
+// and the outputs F (one output) or F0, F1, ...
+class CoverFormatter{
+private:
+    // Counts the characters in the first pass, writes them in the second one
+    struct Counter{
+        size_t size;
+        void put(char){ ++size; }
+        void put(const string& s){ size += s.size(); }
+        void put(const char* s){ size += strlen(s); }
+        void putIf(char, bool keep){ size += keep; }
+    };
+    struct Writer{
+        char* at;
+        void put(char c){ *at++ = c; }
+        void put(const string& s){
+            if(s.size() == 1) *at++ = s[0]; // Most names are one character
+            else{ memcpy(at, s.data(), s.size()); at += s.size(); }
+        }
+        void put(const char* s){ size_t n = strlen(s); memcpy(at, s, n); at += n; }
+        void putIf(char c, bool keep){ *at = c; at += keep; } // Without a branch, so the buffer has one more byte
+    };
+    int numberOfInputs, numberOfOutputs;
+    vector<string> inputNames, outputNames;
+    string modelName;
+    bool shortNames; // Every input name is one character, so literals of the equation are not separated
+    template<class Sink> void emit(Sink& sink, const vector<Cube>& cover, const vector<ull>& outputs, CoverFormat format);
+    // The sink is passed by value, so that its pointer stays in a register while characters are stored
+    template<class Sink> Sink emitRows(Sink sink, const vector<Cube>& cover, const vector<ull>& outputs, int output);
+    template<class Sink> Sink emitTerms(Sink sink, const vector<Cube>& cover, const vector<ull>& outputs, int output, bool verilog);
+public:
+    CoverFormatter(int numberOfInputs, int numberOfOutputs=1);
+    void setInputNames(const vector<string>& names);
+    void setOutputNames(const vector<string>& names);
+    void setModelName(const string& name);
+    void write(const vector<Cube>& cover, const vector<ull>& outputs, CoverFormat format, string& out);
+    string format(const vector<Cube>& cover, CoverFormat format);
+    string format(const vector<Cube>& cover, const vector<ull>& outputs, CoverFormat format);
+};
+
+CoverFormatter::CoverFormatter(int numberOfInputs, int numberOfOutputs){
+    this->numberOfInputs = numberOfInputs;
+    this->numberOfOutputs = numberOfOutputs;
+    for(int k = 0; k < numberOfInputs; ++k)
+        inputNames.push_back(numberOfInputs <= 26 ? string(1, 'a' + k) : "x" + to_string(k));
+    shortNames = numberOfInputs <= 26;
+    for(int o = 0; o < numberOfOutputs; ++o)
+        outputNames.push_back(numberOfOutputs == 1 ? "F" : "F" + to_string(o));
+    modelName = "F";
+}
+void CoverFormatter::setInputNames(const vector<string>& names){
+    // Inputs without a name keep the default one
+    shortNames = true;
+    for(int k = 0; k < numberOfInputs; ++k){
+        if(k < names.size() && !names[k].empty())
+            inputNames[k] = names[k];
+        shortNames &= inputNames[k].size() == 1;
+    }
+}
+void CoverFormatter::setOutputNames(const vector<string>& names){
+    for(int o = 0; o < numberOfOutputs && o < names.size(); ++o)
+        if(!names[o].empty())
+            outputNames[o] = names[o];
+}
+void CoverFormatter::setModelName(const string& name){
+    modelName = name;
+}
+template<class Sink> Sink CoverFormatter::emitRows(Sink sink, const vector<Cube>& cover, const vector<ull>& outputs, int output){
+    // One PLA row per cube, output -1 writes the output part of every output
+    for(int i = 0; i < cover.size(); ++i){
+        if(output >= 0 && !(outputs[i] >> output & 1)) continue;
+        for(int k = numberOfInputs - 1; k >= 0; --k)
+            sink.put("01--"[(cover[i].ask >> k & 1) * 2 + (cover[i].bits >> k & 1)]);
+        sink.put(' ');
+        if(output >= 0)
+            sink.put('1');
+        else
+            for(int o = 0; o < numberOfOutputs; ++o)
+                sink.put(outputs[i] >> o & 1 ? '1' : '0');
+        sink.put('\n');
+    }
+    return sink;
+}
+template<class Sink> Sink CoverFormatter::emitTerms(Sink sink, const vector<Cube>& cover, const vector<ull>& outputs, int output, bool verilog){
+    // Sum of products of one output, only the literals of the cube are visited
+    ull inputMask = numberOfInputs >= 64 ? ~0ULL : (1ULL << numberOfInputs) - 1;
+    bool first = true;
+    for(int i = 0; i < cover.size(); ++i){
+        if(!(outputs[i] >> output & 1)) continue;
+        if(!first)
+            sink.put(verilog ? " | " : " + ");
+        first = false;
+        ull care = ~cover[i].ask & inputMask;
+        if(verilog && !care)
+            sink.put("1'b1");
+        for(bool firstLiteral = true; care; firstLiteral = false){
+            int bit = 63 - __builtin_clzll(care);
+            care ^= 1ULL << bit;
+            bool positive = cover[i].bits >> bit & 1;
+            if(verilog){
+                if(!firstLiteral) sink.put(" & ");
+                sink.putIf('~', !positive);
+                sink.put(inputNames[numberOfInputs - 1 - bit]);
+            }else{
+                if(!firstLiteral && !shortNames) sink.put(' ');
+                sink.put(inputNames[numberOfInputs - 1 - bit]);
+                sink.putIf('\'', !positive);
+            }
+        }
+    }
+    if(verilog && first)
+        sink.put("1'b0");
+    return sink;
+}
+template<class Sink> void CoverFormatter::emit(Sink& sink, const vector<Cube>& cover, const vector<ull>& outputs, CoverFormat format){
+    if(format == FORMAT_EQUATION){
+        for(int o = 0; o < numberOfOutputs; ++o){
+            if(o) sink.put('\n');
+            sink.put(outputNames[o]);
+            sink.put(" = ");
+            sink = emitTerms(sink, cover, outputs, o, false);
+        }
+    }else if(format == FORMAT_PLA){
+        sink.put(".i " + to_string(numberOfInputs) + "\n.o " + to_string(numberOfOutputs) + "\n.ilb");
+        for(int k = 0; k < numberOfInputs; ++k){ sink.put(' '); sink.put(inputNames[k]); }
+        sink.put("\n.ob");
+        for(int o = 0; o < numberOfOutputs; ++o){ sink.put(' '); sink.put(outputNames[o]); }
+        sink.put("\n.p " + to_string(cover.size()) + "\n");
+        sink = emitRows(sink, cover, outputs, -1);
+        sink.put(".e\n");
+    }else if(format == FORMAT_BLIF){
+        // A .names block without rows is the constant 0
+        sink.put(".model " + modelName + "\n.inputs");
+        for(int k = 0; k < numberOfInputs; ++k){ sink.put(' '); sink.put(inputNames[k]); }
+        sink.put("\n.outputs");
+        for(int o = 0; o < numberOfOutputs; ++o){ sink.put(' '); sink.put(outputNames[o]); }
+        sink.put('\n');
+        for(int o = 0; o < numberOfOutputs; ++o){
+            sink.put(".names");
+            for(int k = 0; k < numberOfInputs; ++k){ sink.put(' '); sink.put(inputNames[k]); }
+            sink.put(' ');
+            sink.put(outputNames[o]);
+            sink.put('\n');
+            sink = emitRows(sink, cover, outputs, o);
+        }
+        sink.put(".end\n");
+    }else{
+        sink.put("module " + modelName + "(");
+        for(int k = 0; k < numberOfInputs; ++k){ sink.put(k ? ", " : "input "); sink.put(inputNames[k]); }
+        for(int o = 0; o < numberOfOutputs; ++o){ sink.put(o ? ", " : numberOfInputs ? ", output " : "output "); sink.put(outputNames[o]); }
+        sink.put(");\n");
+        for(int o = 0; o < numberOfOutputs; ++o){
+            sink.put("    assign ");
+            sink.put(outputNames[o]);
+            sink.put(" = ");
+            sink = emitTerms(sink, cover, outputs, o, true);
+            sink.put(";\n");
+        }
+        sink.put("endmodule\n");
+    }
+}
+void CoverFormatter::write(const vector<Cube>& cover, const vector<ull>& outputs, CoverFormat format, string& out){
+    // Appended to out, which is sized by the first pass
+    Counter counter{0};
+    emit(counter, cover, outputs, format);
+    size_t begin = out.size();
+    out.resize(begin + counter.size + 1);
+    Writer writer{&out[0] + begin};
+    emit(writer, cover, outputs, format);
+    out.resize(begin + counter.size);
+}
+string CoverFormatter::format(const vector<Cube>& cover, CoverFormat format){
+    return this->format(cover, vector<ull>(cover.size(), 1), format);
+}
+string CoverFormatter::format(const vector<Cube>& cover, const vector<ull>& outputs, CoverFormat format){
+    string out;
+    write(cover, outputs, format, out);
+    return out;
+}
+#endif
@@ -0,0 +1,36 @@
+/*
+
+title: Cube.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef CUBE_H
+#define CUBE_H
+using namespace std;
+
+typedef unsigned long long int ull;
+
+// Product term as (bits, ask): ask has a 1 on every position that is '-'
+struct Cube{
+    ull bits, ask;
+    Cube(){
+        bits = 0; ask = 0;
+    }
+    Cube(ull bits, ull ask){
+        this->bits = bits & ~ask;
+        this->ask = ask;
+    }
+    bool contains(const Cube& another)const{
+        return (ask & another.ask) == another.ask && ((bits ^ another.bits) & ~ask) == 0;
+    }
+    bool intersects(const Cube& another)const{
+        return ((bits ^ another.bits) & ~ask & ~another.ask) == 0;
+    }
+    bool operator<(const Cube& another)const{
+        return ask != another.ask ? ask < another.ask : bits < another.bits;
+    }
+    bool operator==(const Cube& another)const{
+        return bits == another.bits && ask == another.ask;
+    }
+};
+#endif
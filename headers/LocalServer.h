@@ -0,0 +1,307 @@
+/*
+
+title: LocalServer.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef LOCAL_SERVER_H
+#define LOCAL_SERVER_H
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include <sstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "TabularMethodSolver.h"
+#include "ThreadPool.h"
+#define MAX_FRAME_SIZE (64 << 20)
+using namespace std;
+
+typedef unsigned long long int ull;
+
+// Every message is a frame: 4 byte little endian length and that many bytes of text.
+// Request frame: one problem per line, "<id> <engine> <n> <m> <minterms...> <d> <don't cares...>" with n inputs (at most 63)
+// Response frame: one per problem as soon as it is solved, "<id> OK <equation>" or "<id> ERR <message>"
+struct MinimizeRequest{
+    ull id;
+    string engine;
+    int numberOfInputs;
+    vector<ull> minterms, dontcares;
+};
+struct MinimizeResult{
+    ull id;
+    bool ok;
+    string answer;
+};
+
+bool writeFrame(int fd, const string& payload){
+    string frame(4, 0);
+    for(int i = 0; i < 4; ++i)
+        frame[i] = (char)(payload.size() >> (8 * i) & 255);
+    frame += payload;
+    for(size_t done = 0; done < frame.size(); ){
+        ssize_t n = send(fd, frame.data() + done, frame.size() - done, MSG_NOSIGNAL);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) return false;
+        done += n;
+    }
+    return true;
+}
+bool readBytes(int fd, char* buffer, size_t size){
+    for(size_t done = 0; done < size; ){
+        ssize_t n = read(fd, buffer + done, size - done);
+        if(n < 0 && errno == EINTR) continue;
+        if(n <= 0) return false;
+        done += n;
+    }
+    return true;
+}
+bool readFrame(int fd, string& payload){
+    unsigned char header[4];
+    if(!readBytes(fd, (char*)header, 4))
+        return false;
+    size_t size = header[0] | header[1] << 8 | header[2] << 16 | (size_t)header[3] << 24;
+    if(size > MAX_FRAME_SIZE)
+        return false;
+    payload.resize(size);
+    return size == 0 || readBytes(fd, &payload[0], size);
+}
+string formatRequest(const MinimizeRequest& request){
+    string line = to_string(request.id) + " " + request.engine + " " + to_string(request.numberOfInputs) + " " + to_string(request.minterms.size());
+    for(auto m: request.minterms) line += " " + to_string(m);
+    line += " " + to_string(request.dontcares.size());
+    for(auto d: request.dontcares) line += " " + to_string(d);
+    return line;
+}
+bool parseRequest(const string& line, MinimizeRequest& request){
+    istringstream in(line);
+    size_t m, d;
+    if(!(in >> request.id >> request.engine >> request.numberOfInputs) || request.numberOfInputs < 0 || request.numberOfInputs > 63)
+        return false;
+    if(!(in >> m) || m > line.size())
+        return false;
+    request.minterms.resize(m);
+    for(size_t i = 0; i < m; ++i)
+        if(!(in >> request.minterms[i])) return false;
+    if(!(in >> d) || d > line.size())
+        return false;
+    request.dontcares.resize(d);
+    for(size_t i = 0; i < d; ++i)
+        if(!(in >> request.dontcares[i])) return false;
+    return true;
+}
+
+class LocalServer{
+private:
+    struct Connection{
+        int fd;
+        mutex writeLock;
+        ~Connection(){
+            close(fd);
+        }
+    };
+    string path;
+    int listenFd;
+    long long timeLimit;
+    size_t batchTerms;
+    atomic<bool> running;
+    mutex connectionsLock;
+    set<int> connections; // Open for reading, shut down by stop()
+    map<int, thread> readers; // Reader thread of every connection, only used by run()
+    vector<int> finishedReaders; // Readers that returned and can be joined, guarded by connectionsLock
+    vector<ResultCache> caches; // One per worker, so they are used without a lock
+    ThreadPool pool; // Declared last, so the workers are joined before the caches are destroyed
+    void serve(shared_ptr<Connection> conn, int reader);
+    void joinFinishedReaders();
+    void solveBatch(shared_ptr<Connection> conn, const vector<MinimizeRequest>& batch);
+public:
+    LocalServer(const string& path, int numberOfThreads, size_t cacheCapacity=4096, size_t batchTerms=256);
+    void setTimeLimit(long long ms);
+    bool run();
+    void stop(); // Only an atomic store and shutdown(), so it can be called from a signal handler
+};
+
+LocalServer::LocalServer(const string& path, int numberOfThreads, size_t cacheCapacity, size_t batchTerms)
+    : caches(max(1, numberOfThreads), ResultCache(cacheCapacity)), pool(numberOfThreads){
+    this->path = path;
+    this->batchTerms = batchTerms;
+    listenFd = -1;
+    timeLimit = 1000;
+    running = false;
+}
+void LocalServer::setTimeLimit(long long ms){
+    timeLimit = ms;
+}
+bool LocalServer::run(){
+    // Accepts connections until stop(), every connection is read by its own thread
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(addr.sun_path))
+        return false;
+    strcpy(addr.sun_path, path.c_str());
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listenFd < 0)
+        return false;
+    unlink(path.c_str());
+    if(::bind(listenFd, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listenFd, SOMAXCONN) < 0){
+        close(listenFd);
+        return false;
+    }
+    running = true;
+    for(int nextReader = 0; running; ++nextReader){
+        joinFinishedReaders(); // Threads of closed connections are joined while the server runs
+        int fd = accept(listenFd, NULL, NULL);
+        if(fd < 0){
+            if(running && errno == EINTR) continue;
+            break;
+        }
+        shared_ptr<Connection> conn = make_shared<Connection>();
+        conn->fd = fd;
+        {
+            lock_guard<mutex> guard(connectionsLock);
+            connections.insert(fd);
+        }
+        readers[nextReader] = thread(&LocalServer::serve, this, conn, nextReader);
+    }
+    {
+        lock_guard<mutex> guard(connectionsLock);
+        for(int fd: connections)
+            shutdown(fd, SHUT_RD);
+    }
+    for(auto& reader: readers)
+        reader.second.join();
+    readers.clear();
+    finishedReaders.clear();
+    close(listenFd);
+    unlink(path.c_str());
+    return true;
+}
+void LocalServer::stop(){
+    running = false;
+    if(listenFd >= 0)
+        shutdown(listenFd, SHUT_RDWR);
+}
+void LocalServer::joinFinishedReaders(){
+    vector<int> finished;
+    {
+        lock_guard<mutex> guard(connectionsLock);
+        finished.swap(finishedReaders);
+    }
+    for(int reader: finished){
+        readers[reader].join();
+        readers.erase(reader);
+    }
+}
+void LocalServer::serve(shared_ptr<Connection> conn, int reader){
+    // Small problems are batched into one task until they have batchTerms terms
+    string payload;
+    while(readFrame(conn->fd, payload)){
+        istringstream lines(payload);
+        string line;
+        vector<MinimizeRequest> batch;
+        size_t terms = 0;
+        while(getline(lines, line)){
+            if(line.empty()) continue;
+            MinimizeRequest request;
+            request.id = 0;
+            if(!parseRequest(line, request)){
+                lock_guard<mutex> guard(conn->writeLock);
+                writeFrame(conn->fd, to_string(request.id) + " ERR malformed request");
+                continue;
+            }
+            terms += request.minterms.size() + request.dontcares.size();
+            batch.push_back(move(request));
+            if(terms >= batchTerms){
+                pool.submit([this, conn, batch](){ solveBatch(conn, batch); });
+                batch.clear();
+                terms = 0;
+            }
+        }
+        if(!batch.empty())
+            pool.submit([this, conn, batch](){ solveBatch(conn, batch); });
+    }
+    lock_guard<mutex> guard(connectionsLock);
+    connections.erase(conn->fd);
+    finishedReaders.push_back(reader);
+}
+void LocalServer::solveBatch(shared_ptr<Connection> conn, const vector<MinimizeRequest>& batch){
+    ResultCache& cache = caches[ThreadPool::workerIndex()];
+    for(auto& request: batch){
+        string response = to_string(request.id);
+        SolveMode mode;
+        if(!parseEngine(request.engine, mode))
+            response += " ERR unknown engine";
+        else{
+            try{
+                vector<ull> minterms(request.minterms), dontcares(request.dontcares);
+                Tabular tabular(request.numberOfInputs, minterms, dontcares);
+                tabular.setCache(&cache);
+                tabular.setTimeLimit(timeLimit);
+                response += " OK " + tabular.solve(mode);
+            }catch(exception& e){
+                response += string(" ERR ") + e.what();
+            }
+        }
+        lock_guard<mutex> guard(conn->writeLock);
+        writeFrame(conn->fd, response);
+    }
+}
+
+class LocalClient{
+private:
+    int fd;
+public:
+    LocalClient();
+    ~LocalClient();
+    bool connect(const string& path);
+    bool send(const vector<MinimizeRequest>& batch);
+    bool receive(MinimizeResult& result);
+};
+
+LocalClient::LocalClient(){
+    fd = -1;
+}
+LocalClient::~LocalClient(){
+    if(fd >= 0)
+        close(fd);
+}
+bool LocalClient::connect(const string& path){
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(addr.sun_path))
+        return false;
+    strcpy(addr.sun_path, path.c_str());
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    return fd >= 0 && ::connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+}
+bool LocalClient::send(const vector<MinimizeRequest>& batch){
+    string payload;
+    for(auto& request: batch)
+        payload += formatRequest(request) + "\n";
+    return writeFrame(fd, payload);
+}
+bool LocalClient::receive(MinimizeResult& result){
+    // Results come in the order they are solved, not in the order they were sent
+    string payload;
+    if(!readFrame(fd, payload))
+        return false;
+    size_t first = payload.find(' '), second = payload.find(' ', first + 1);
+    if(first == string::npos)
+        return false;
+    result.id = strtoull(payload.c_str(), NULL, 10);
+    string status = payload.substr(first + 1, second == string::npos ? string::npos : second - first - 1);
+    result.ok = status == "OK";
+    result.answer = second == string::npos ? "" : payload.substr(second + 1);
+    return true;
+}
+#endif
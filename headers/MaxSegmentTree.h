@@ -4,6 +4,8 @@ title: MaxSegmentTree.h
 author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
 
 */
+#ifndef MAX_SEGMENT_TREE_H
+#define MAX_SEGMENT_TREE_H
 #include <vector>
 using namespace std;
 
@@ -71,4 +73,5 @@ public:
         }
         return ret;
     }
-};
\ No newline at end of file
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,404 @@
+/*
+
+title: MultiOutputSolver.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef MULTI_OUTPUT_SOLVER_H
+#define MULTI_OUTPUT_SOLVER_H
+#include "TabularMethodSolver.h"
+
+// Minimizes several functions over the same inputs at once.
+// Every implicant carries a tag (Impcnt::getOutputs) of the outputs it can be used in,
+// so a single product term can be shared between outputs (one PLA row).
+class MultiTabular{
+private:
+    vector<vector<ull>> minterms, dontcares;
+    vector<Impcnt> PIs;
+    int numberOfInputs, numberOfOutputs, totNumberOfEPI;
+    bool fixedInputs; // numberOfInputs was given, so wider terms are rejected instead of growing it
+    vector<string> inputNames, outputNames;
+    void fitTerm(int output, ull term);
+    void addMin(int output, ull m);
+    void addDon(int output, ull d);
+    bool isMinterm(int output, ull term);
+    void outputCover(const vector<int>& ans, vector<Cube>& cover, vector<ull>& outputs);
+    vector<int> runSolve(bool approx, bool showProcess);
+public:
+    MultiTabular(int numberOfOutputs);
+    MultiTabular(int numberOfInputs, int numberOfOutputs);
+    MultiTabular(vector<vector<ull>>& mins, vector<vector<ull>>& donts);
+    void addMinterm(int output, ull m);
+    void addDontcare(int output, ull d);
+    void setInputNames(const vector<string>& names);
+    void setOutputNames(const vector<string>& names);
+    void getPI();
+    void getEPI();
+    void buildGraph(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& rev);
+    vector<int> approximationSolver();
+    vector<int> trueSolver();
+    vector<string> ansToString(const vector<int>& ans);
+    string ansToString(const vector<int>& ans, CoverFormat format);
+    vector<string> solve(bool approx, bool showProcess=false);
+    string solve(bool approx, CoverFormat format, bool showProcess=false);
+    int solveTest(bool approx);
+};
+
+void MultiTabular::fitTerm(int output, ull term){
+    // Same rules as Tabular::fitInputs, and the output has to exist
+    if(output < 0 || output >= numberOfOutputs)
+        throw out_of_range("output index out of range");
+    int width = term ? 64 - __builtin_clzll(term) : 0;
+    if(fixedInputs){
+        if(width > numberOfInputs)
+            throw out_of_range("term uses more inputs than the function has");
+        return;
+    }
+    numberOfInputs = max(numberOfInputs, width);
+}
+void MultiTabular::addMin(int output, ull m){
+    fitTerm(output, m);
+    minterms[output].push_back(m);
+}
+void MultiTabular::addDon(int output, ull d){
+    fitTerm(output, d);
+    dontcares[output].push_back(d);
+}
+bool MultiTabular::isMinterm(int output, ull term){
+    return binary_search(minterms[output].begin(), minterms[output].end(), term);
+}
+MultiTabular::MultiTabular(int numberOfOutputs){
+    // Every output is a bit of the implicant tags
+    if(numberOfOutputs < 0 || numberOfOutputs > MAX_OUTPUTS)
+        throw invalid_argument("number of outputs must be in [0, MAX_OUTPUTS]");
+    numberOfInputs = 0;
+    fixedInputs = false;
+    this->numberOfOutputs = numberOfOutputs;
+    minterms.resize(numberOfOutputs);
+    dontcares.resize(numberOfOutputs);
+}
+MultiTabular::MultiTabular(int numberOfInputs, int numberOfOutputs): MultiTabular(numberOfOutputs){
+    // The inputs are not narrowed to the highest bit in use, so that the output keeps every input
+    if(numberOfInputs < 0 || numberOfInputs > MAX_INPUTS)
+        throw invalid_argument("number of inputs must be in [0, MAX_INPUTS]");
+    this->numberOfInputs = numberOfInputs;
+    fixedInputs = true;
+}
+MultiTabular::MultiTabular(vector<vector<ull>>& mins, vector<vector<ull>>& donts): MultiTabular((int)max(mins.size(), donts.size())){
+    for(int o = 0; o < mins.size(); ++o)
+        for(auto m: mins[o])
+            addMin(o, m);
+    for(int o = 0; o < donts.size(); ++o)
+        for(auto d: donts[o])
+            addDon(o, d);
+}
+void MultiTabular::addMinterm(int output, ull m){
+    addMin(output, m);
+}
+void MultiTabular::addDontcare(int output, ull d){
+    addDon(output, d);
+}
+void MultiTabular::setInputNames(const vector<string>& names){
+    inputNames = names;
+}
+void MultiTabular::setOutputNames(const vector<string>& names){
+    outputNames = names;
+}
+void MultiTabular::getPI(){
+    for(int o = 0; o < numberOfOutputs; ++o)
+        sort(minterms[o].begin(), minterms[o].end());
+
+    // Tag of a minterm = outputs where it is either minterm or don't care
+    map<ull, ull> tags;
+    for(int o = 0; o < numberOfOutputs; ++o){
+        for(auto m: minterms[o])
+            tags[m] |= 1ULL << o;
+        for(auto d: dontcares[o])
+            tags[d] |= 1ULL << o;
+    }
+
+    vector<vector<vector<Impcnt>>> lists;
+    vector<vector<Impcnt>> firstList(numberOfInputs + 1);
+    for(auto itr = tags.begin(); itr != tags.end(); ++itr){
+        Impcnt imp(numberOfInputs, itr->first);
+        imp.setOutputs(itr->second);
+        firstList[__builtin_popcountll(itr->first)].push_back(imp);
+    }
+    lists.push_back(firstList);
+    for(int i = 1; ; ++i){
+        vector<vector<Impcnt>> nList(numberOfInputs + 1);
+        vector<vector<Impcnt>>& lList = lists.back();
+
+        bool changed = false;
+
+        for(int j = 0; j < numberOfInputs; ++j){
+            set<string> duplicates;
+            for(int l = 0; l < lList[j].size(); ++l){
+                for(int n = 0; n < lList[j + 1].size(); ++n){
+                    ull common = lList[j][l].getOutputs() & lList[j + 1][n].getOutputs();
+                    if(!common) // No output can use the combined term
+                        continue;
+                    int dist = lList[j][l].getBits().hammingDist(lList[j + 1][n].getBits());
+                    if(dist == 1){ // Combine
+                        // An implicant is only covered when the combined term keeps all of its outputs
+                        if(common == lList[j][l].getOutputs())
+                            lList[j][l].setCheck();
+                        if(common == lList[j + 1][n].getOutputs())
+                            lList[j + 1][n].setCheck();
+
+                        Impcnt newCircle = lList[j][l].returnCombined(lList[j + 1][n]);
+                        string hash = newCircle.getBits().toString();
+                        if(duplicates.find(hash) == duplicates.end()){
+                            duplicates.insert(hash);
+
+                            nList[j].push_back(newCircle);
+                            changed = true;
+                        }
+                    }
+                }
+            }
+        }
+        if(!changed)
+            break;
+        lists.push_back(nList);
+    }
+    PIs.clear();
+    for(int i = 0; i < lists.size(); ++i)
+        for(int j = 0; j <= numberOfInputs - i; ++j)
+            for(int k = 0; k < lists[i][j].size(); ++k){
+                if(lists[i][j][k].getCheck())
+                    continue;
+                // Dropping tagged PIs that cover only don't cares
+                bool useful = false;
+                for(int o = 0; o < numberOfOutputs && !useful; ++o){
+                    if(!(lists[i][j][k].getOutputs() >> o & 1)) continue;
+                    for(int t = 0; t < lists[i][j][k].getNumberOfTerms() && !useful; ++t)
+                        useful = isMinterm(o, lists[i][j][k].getTerm(t));
+                }
+                if(useful)
+                    PIs.push_back(lists[i][j][k]);
+            }
+}
+void MultiTabular::getEPI(){
+    // Coordinate compression over (output, minterm) pairs
+    map<pair<int, ull>, int> comp;
+    int n = 0;
+    for(int o = 0; o < numberOfOutputs; ++o)
+        for(auto m: minterms[o])
+            if(comp.find(make_pair(o, m)) == comp.end())
+                comp[make_pair(o, m)] = n++;
+
+    // Finding EPI
+    totNumberOfEPI = 0;
+    vector<int> cnt(n, 0), last(n, -1);
+    for(int i = 0; i < PIs.size(); ++i){
+        for(int o = 0; o < numberOfOutputs; ++o){
+            if(!(PIs[i].getOutputs() >> o & 1)) continue;
+            for(int j = 0; j < PIs[i].getNumberOfTerms(); ++j){
+                auto itr = comp.find(make_pair(o, PIs[i].getTerm(j)));
+                if(itr == comp.end()) continue;
+                ++cnt[itr->second];
+                last[itr->second] = i;
+            }
+        }
+    }
+
+    // Eliminating EPI
+    for(int compPos = 0; compPos < n; ++compPos){
+        if(cnt[compPos] == 1){
+            if(PIs[last[compPos]].getEPI()) // Already EPI
+                continue;
+            PIs[last[compPos]].setEPI(); // EPI Found!
+            ++totNumberOfEPI;
+        }
+    }
+}
+void MultiTabular::buildGraph(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& rev){
+    // (output, minterm) pairs that are not satisfied by EPIs
+    set<pair<int, ull>> positions;
+    for(int o = 0; o < numberOfOutputs; ++o)
+        for(auto m: minterms[o])
+            positions.insert(make_pair(o, m));
+    for(int i = 0; i < PIs.size(); ++i){
+        if(!PIs[i].getEPI())
+            continue;
+        for(int o = 0; o < numberOfOutputs; ++o){
+            if(!(PIs[i].getOutputs() >> o & 1)) continue;
+            for(int j = 0; j < PIs[i].getNumberOfTerms(); ++j)
+                positions.erase(make_pair(o, PIs[i].getTerm(j)));
+        }
+    }
+    map<pair<int, ull>, int> comp;
+    int n = 0;
+    for(auto itr = positions.begin(); itr != positions.end(); ++itr)
+        comp[*itr] = n++;
+
+    // Building Bipartite Graph to solve Set Cover problem
+    GL.resize(PIs.size() - totNumberOfEPI); GR.resize(n);
+    for(int i = 0, v = 0; i < PIs.size(); ++i){
+        if(PIs[i].getEPI())
+            continue;
+        rev.push_back(i);
+        for(int o = 0; o < numberOfOutputs; ++o){
+            if(!(PIs[i].getOutputs() >> o & 1)) continue;
+            for(int j = 0; j < PIs[i].getNumberOfTerms(); ++j){
+                auto itr = comp.find(make_pair(o, PIs[i].getTerm(j)));
+                if(itr == comp.end()) continue;
+                GL[v].push_back(itr->second);
+                GR[itr->second].push_back(v);
+            }
+        }
+        ++v;
+    }
+}
+vector<int> MultiTabular::approximationSolver(){
+    vector<vector<int>> GL, GR;
+    vector<int> rev, ans;
+    buildGraph(GL, GR, rev);
+
+    vector<int> solCase;
+    if(!GR.empty())
+        Tabular::greedy(GL, GR, solCase);
+
+    for(int i = 0; i < solCase.size(); ++i)
+        ans.push_back(rev[solCase[i]]);
+    return ans;
+}
+vector<int> MultiTabular::trueSolver(){
+    vector<vector<int>> GL, GR;
+    vector<int> rev, ans;
+    buildGraph(GL, GR, rev);
+
+    int minCost = -1;
+    vector<int> solCase;
+    if(!GR.empty())
+        Tabular::bruteForce(GL, GR.size(), solCase, minCost);
+
+    for(int i = 0; i < solCase.size(); ++i)
+        ans.push_back(rev[solCase[i]]);
+    return ans;
+}
+void MultiTabular::outputCover(const vector<int>& ans, vector<Cube>& cover, vector<ull>& outputs){
+    // cover[i] is PI ans[i], outputs[i] = outputs it is written to
+    cover.resize(ans.size());
+    outputs.assign(ans.size(), 0);
+    for(int i = 0; i < ans.size(); ++i)
+        cover[i] = PIs[ans[i]].getCube();
+    for(int o = 0; o < numberOfOutputs; ++o){
+        // Shared terms that are redundant for this output are not written to it
+        vector<int> used;
+        map<ull, int> cnt;
+        for(int i = 0; i < ans.size(); ++i){
+            int j = ans[i];
+            if(!(PIs[j].getOutputs() >> o & 1)) continue;
+            used.push_back(i);
+            for(int t = 0; t < PIs[j].getNumberOfTerms(); ++t)
+                if(isMinterm(o, PIs[j].getTerm(t)))
+                    ++cnt[PIs[j].getTerm(t)];
+        }
+        vector<int> order(used);
+        stable_sort(order.begin(), order.end(), [&](int a, int b){
+            return PIs[ans[a]].getNumberOfTerms() < PIs[ans[b]].getNumberOfTerms();
+        });
+        set<int> redundant;
+        for(int i = 0; i < order.size(); ++i){
+            int j = ans[order[i]];
+            bool needed = false;
+            for(int t = 0; t < PIs[j].getNumberOfTerms() && !needed; ++t){
+                auto itr = cnt.find(PIs[j].getTerm(t));
+                needed = itr != cnt.end() && itr->second == 1;
+            }
+            if(needed) continue;
+            redundant.insert(order[i]);
+            for(int t = 0; t < PIs[j].getNumberOfTerms(); ++t){
+                auto itr = cnt.find(PIs[j].getTerm(t));
+                if(itr != cnt.end()) --itr->second;
+            }
+        }
+        for(int i: used)
+            if(!redundant.count(i))
+                outputs[i] |= 1ULL << o;
+    }
+}
+vector<string> MultiTabular::ansToString(const vector<int>& ans){
+    vector<Cube> cover;
+    vector<ull> outputs;
+    outputCover(ans, cover, outputs);
+    vector<string> eqs(numberOfOutputs);
+    for(int o = 0; o < numberOfOutputs; ++o){
+        // Each output is an equation of its own, written with the cubes of that output
+        CoverFormatter formatter(numberOfInputs);
+        formatter.setInputNames(inputNames);
+        formatter.setOutputNames({o < outputNames.size() && !outputNames[o].empty() ? outputNames[o] : "F" + to_string(o)});
+        vector<ull> mine(outputs.size());
+        for(int i = 0; i < outputs.size(); ++i)
+            mine[i] = outputs[i] >> o & 1;
+        formatter.write(cover, mine, FORMAT_EQUATION, eqs[o]);
+    }
+    return eqs;
+}
+string MultiTabular::ansToString(const vector<int>& ans, CoverFormat format){
+    // Every output in one document, a cube shared by outputs is one PLA row
+    vector<Cube> cover;
+    vector<ull> outputs;
+    outputCover(ans, cover, outputs);
+    vector<Cube> rows;
+    vector<ull> rowOutputs;
+    for(int i = 0; i < cover.size(); ++i)
+        if(outputs[i]){
+            rows.push_back(cover[i]);
+            rowOutputs.push_back(outputs[i]);
+        }
+    CoverFormatter formatter(numberOfInputs, numberOfOutputs);
+    formatter.setInputNames(inputNames);
+    formatter.setOutputNames(outputNames);
+    string out;
+    formatter.write(rows, rowOutputs, format, out);
+    return out;
+}
+vector<int> MultiTabular::runSolve(bool approx, bool showProcess){
+    if(showProcess)
+        cout << "# Getting tagged PI(s)..." << endl;
+    getPI();
+    if(showProcess){
+        cout << "Number of PIs: " << PIs.size() << endl;
+        for(int i = 0; i < PIs.size(); ++i){
+            cout << PIs[i].getBits().toString() << " [outputs " << PIs[i].getOutputs() << "]: ";
+            PIs[i].printTerms(); cout << endl;
+        }
+    }
+    if(showProcess)
+        cout << "# Getting EPI(s)..." << endl;
+    getEPI();
+    if(showProcess)
+        cout << "Number of EPIs: " << totNumberOfEPI << endl;
+    if(showProcess)
+        cout << "# Getting Solution..." << endl;
+    vector<int> ans;
+    if(approx)
+        ans = approximationSolver();
+    else
+        ans = trueSolver();
+    for(int i = 0; i < PIs.size(); ++i)
+        if(PIs[i].getEPI())
+            ans.push_back(i);
+    sort(ans.begin(), ans.end());
+    return ans;
+}
+vector<string> MultiTabular::solve(bool approx, bool showProcess){
+    return ansToString(runSolve(approx, showProcess));
+}
+string MultiTabular::solve(bool approx, CoverFormat format, bool showProcess){
+    return ansToString(runSolve(approx, showProcess), format);
+}
+int MultiTabular::solveTest(bool approx){
+    getPI();
+    getEPI();
+    vector<int> ans;
+    if(approx)
+        ans = approximationSolver();
+    else
+        ans = trueSolver();
+    return ans.size() + totNumberOfEPI;
+}
+#endif
\ No newline at end of file
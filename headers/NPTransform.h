@@ -0,0 +1,141 @@
+/*
+
+title: NPTransform.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef NP_TRANSFORM_H
+#define NP_TRANSFORM_H
+#include <algorithm>
+#include <vector>
+#include "Cube.h"
+using namespace std;
+
+typedef unsigned long long int ull;
+
+// Permutation and complementation of the inputs: y = permute(x) ^ neg, bit i of x goes to bit perm[i] of y
+struct NPTransform{
+    vector<int> perm;
+    ull neg;
+    NPTransform(int numberOfInputs=0);
+    bool isIdentity() const;
+    ull apply(ull x) const;
+    Cube apply(const Cube& c) const;
+    Cube invert(const Cube& c) const;
+    static NPTransform canonical(int numberOfInputs, vector<ull> ons, vector<ull> dcs, size_t candidateLimit=720);
+};
+
+NPTransform::NPTransform(int numberOfInputs){
+    for(int i = 0; i < numberOfInputs; ++i)
+        perm.push_back(i);
+    neg = 0;
+}
+bool NPTransform::isIdentity() const{
+    for(int i = 0; i < perm.size(); ++i)
+        if(perm[i] != i) return false;
+    return neg == 0;
+}
+ull NPTransform::apply(ull x) const{
+    ull y = 0;
+    for(int i = 0; i < perm.size(); ++i)
+        y |= (x >> i & 1) << perm[i];
+    return y ^ neg;
+}
+Cube NPTransform::apply(const Cube& c) const{
+    ull bits = 0, ask = 0;
+    for(int i = 0; i < perm.size(); ++i){
+        bits |= (c.bits >> i & 1) << perm[i];
+        ask |= (c.ask >> i & 1) << perm[i];
+    }
+    return Cube(bits ^ neg, ask);
+}
+Cube NPTransform::invert(const Cube& c) const{
+    ull b = c.bits ^ (neg & ~c.ask), bits = 0, ask = 0;
+    for(int i = 0; i < perm.size(); ++i){
+        bits |= (b >> perm[i] & 1) << i;
+        ask |= (c.ask >> perm[i] & 1) << i;
+    }
+    return Cube(bits, ask);
+}
+NPTransform NPTransform::canonical(int numberOfInputs, vector<ull> ons, vector<ull> dcs, size_t candidateLimit){
+    // Representative of the class = transform with the smallest sorted (ON, DC) sets.
+    // Only transforms that agree with the per-variable signatures are tried.
+    // Output negation is not used because it doesn't preserve the cost of a SOP cover.
+    int n = numberOfInputs;
+    sort(ons.begin(), ons.end());
+    ons.erase(unique(ons.begin(), ons.end()), ons.end());
+    sort(dcs.begin(), dcs.end());
+    dcs.erase(unique(dcs.begin(), dcs.end()), dcs.end());
+    vector<ull> onlyDcs;
+    set_difference(dcs.begin(), dcs.end(), ons.begin(), ons.end(), back_inserter(onlyDcs));
+    dcs.swap(onlyDcs);
+
+    // Signature of a variable: number of ON / DC points where it is 1, complemented so that it is 0 on most of them
+    ull baseNeg = 0;
+    vector<pair<pair<size_t, size_t>, int>> sig;
+    vector<int> ambiguous; // Both polarities give the same signature
+    for(int i = 0; i < n; ++i){
+        size_t on1 = 0, dc1 = 0;
+        for(auto m: ons) on1 += m >> i & 1;
+        for(auto d: dcs) dc1 += d >> i & 1;
+        size_t on0 = ons.size() - on1, dc0 = dcs.size() - dc1;
+        if(on1 > on0 || (on1 == on0 && dc1 > dc0)){
+            baseNeg |= 1ULL << i;
+            swap(on1, on0); swap(dc1, dc0);
+        }else if(on1 == on0 && dc1 == dc0)
+            ambiguous.push_back(i);
+        sig.push_back(make_pair(make_pair(on1, dc1), i));
+    }
+    sort(sig.begin(), sig.end());
+
+    // Variables with the same signature can be placed in any order
+    vector<vector<int>> groups;
+    vector<int> groupStart;
+    for(int i = 0; i < n; ++i){
+        if(i == 0 || sig[i].first != sig[i - 1].first){
+            groups.push_back(vector<int>());
+            groupStart.push_back(i);
+        }
+        groups.back().push_back(sig[i].second);
+    }
+
+    NPTransform best(n), now(n);
+    vector<ull> bestOns, bestDcs, nowOns, nowDcs;
+    bool found = false;
+    size_t tried = 0;
+    while(tried < candidateLimit){
+        for(int g = 0; g < groups.size(); ++g)
+            for(int k = 0; k < groups[g].size(); ++k)
+                now.perm[groups[g][k]] = groupStart[g] + k;
+        // Polarities of the ambiguous variables
+        for(ull mask = 0; mask < (1ULL << min((int)ambiguous.size(), 20)) && tried < candidateLimit; ++mask, ++tried){
+            ull rawNeg = baseNeg;
+            for(int k = 0; k < ambiguous.size(); ++k)
+                if(mask >> k & 1)
+                    rawNeg |= 1ULL << ambiguous[k];
+            now.neg = 0;
+            for(int i = 0; i < n; ++i) // neg is applied after the permutation
+                now.neg |= (rawNeg >> i & 1) << now.perm[i];
+            nowOns.clear(); nowDcs.clear();
+            for(auto m: ons) nowOns.push_back(now.apply(m));
+            for(auto d: dcs) nowDcs.push_back(now.apply(d));
+            sort(nowOns.begin(), nowOns.end());
+            sort(nowDcs.begin(), nowDcs.end());
+            if(!found || nowOns < bestOns || (nowOns == bestOns && nowDcs < bestDcs)){
+                found = true;
+                best = now;
+                bestOns.swap(nowOns);
+                bestDcs.swap(nowDcs);
+            }
+        }
+        // Next order of the groups, like an odometer
+        int g = 0;
+        for(; g < groups.size(); ++g)
+            if(next_permutation(groups[g].begin(), groups[g].end()))
+                break;
+        if(g == groups.size())
+            break;
+    }
+    return best;
+}
+#endif
@@ -0,0 +1,225 @@
+/*
+
+title: PlaReader.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef PLA_READER_H
+#define PLA_READER_H
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <cstdlib>
+#include <climits>
+#include "TabularMethodSolver.h"
+#include "MultiOutputSolver.h"
+using namespace std;
+
+typedef unsigned long long int ull;
+
+// Function of a Berkeley PLA file (.i, .o, .ilb, .ob, .type f|fd|fr|fdr, .p, .e and cube lines).
+// The output part of a cube puts it in onCubes (1 or 4), dcCubes (- or 2) or offCubes (0 or 3) of every output,
+// and .type tells which of them are used: don't cares with d, the OFF set with r (fd by default).
+// The first input character is the most significant bit, as in the rest of the solver.
+struct PlaFile{
+    int numberOfInputs, numberOfOutputs;
+    string type;
+    vector<string> inputNames, outputNames;
+    vector<vector<Cube>> onCubes, dcCubes, offCubes; // [output]
+    PlaFile();
+    vector<Cube> dontcareCover(int output) const;
+    Tabular toTabular(int output) const;
+    MultiTabular toMultiTabular() const;
+};
+
+PlaFile::PlaFile(){
+    numberOfInputs = numberOfOutputs = -1;
+    type = "fd";
+}
+vector<Cube> PlaFile::dontcareCover(int output) const{
+    // With the OFF set given, every point that is neither ON nor OFF is a don't care, and OFF wins over a don't care
+    vector<Cube> dc;
+    if(type.find('d') != string::npos)
+        dc = dcCubes[output];
+    if(type.find('r') != string::npos){
+        auto remove = [&](vector<Cube>& cover, const vector<Cube>& cubes){
+            for(auto& c: cubes){
+                vector<Cube> pieces;
+                for(int k = 0; k < cover.size(); ++k)
+                    Tabular::sharp(cover[k], c, pieces);
+                cover.swap(pieces);
+            }
+        };
+        ull full = numberOfInputs >= 64 ? ~0ULL : (1ULL << numberOfInputs) - 1;
+        vector<Cube> rest(1, Cube(0, full));
+        remove(rest, onCubes[output]);
+        remove(rest, offCubes[output]);
+        remove(dc, offCubes[output]);
+        dc.insert(dc.end(), rest.begin(), rest.end());
+    }
+    return dc;
+}
+Tabular PlaFile::toTabular(int output) const{
+    // The cubes are given as they are, so PIs are generated by iterated consensus
+    Tabular tabular(numberOfInputs);
+    for(auto& c: onCubes[output])
+        tabular.addMintermCube(c.bits, c.ask);
+    for(auto& c: dontcareCover(output))
+        tabular.addDontcareCube(c.bits, c.ask);
+    tabular.setInputNames(inputNames);
+    if(output < outputNames.size())
+        tabular.setOutputName(outputNames[output]);
+    return tabular;
+}
+MultiTabular PlaFile::toMultiTabular() const{
+    // MultiTabular takes minterms, so every cube is enumerated
+    if(numberOfOutputs > MAX_OUTPUTS)
+        throw invalid_argument("more outputs than MAX_OUTPUTS");
+    MultiTabular tabular(numberOfInputs, numberOfOutputs);
+    for(int o = 0; o < numberOfOutputs; ++o){
+        vector<ull> ons;
+        for(auto& c: onCubes[o])
+            for(ull t = c.ask; ; t = (t - 1) & c.ask){
+                ons.push_back(c.bits | t);
+                if(!t) break;
+            }
+        sort(ons.begin(), ons.end());
+        ons.erase(unique(ons.begin(), ons.end()), ons.end());
+        for(auto m: ons)
+            tabular.addMinterm(o, m);
+        vector<ull> dcs;
+        for(auto& c: dontcareCover(o))
+            for(ull t = c.ask; ; t = (t - 1) & c.ask){
+                if(!binary_search(ons.begin(), ons.end(), c.bits | t))
+                    dcs.push_back(c.bits | t);
+                if(!t) break;
+            }
+        sort(dcs.begin(), dcs.end());
+        dcs.erase(unique(dcs.begin(), dcs.end()), dcs.end());
+        for(auto d: dcs)
+            tabular.addDontcare(o, d);
+    }
+    tabular.setInputNames(inputNames);
+    tabular.setOutputNames(outputNames);
+    return tabular;
+}
+
+bool readPla(istream& in, PlaFile& pla, string& error){
+    // The file is read at once and scanned in place. Spaces may separate the characters of a cube anywhere,
+    // only their number is checked: .i input characters and then .o output characters.
+    string text((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    pla = PlaFile();
+    int lineNumber = 0;
+    bool cubes = false;
+    auto fail = [&](const string& message){
+        error = "line " + to_string(lineNumber) + ": " + message;
+        return false;
+    };
+    auto blank = [](char c){
+        return c == ' ' || c == '\t' || c == '\r' || c == '|';
+    };
+    const char* p = text.c_str();
+    const char* end = p + text.size();
+    while(p < end){
+        const char* eol = (const char*)memchr(p, '\n', end - p);
+        if(!eol) eol = end;
+        const char* q = p;
+        p = eol + 1;
+        ++lineNumber;
+        const char* comment = (const char*)memchr(q, '#', eol - q);
+        if(comment) eol = comment;
+        while(q < eol && blank(*q)) ++q;
+        if(q == eol) continue;
+
+        if(*q == '.'){
+            vector<string> words;
+            while(q < eol){
+                const char* w = q;
+                while(q < eol && !blank(*q)) ++q;
+                words.push_back(string(w, q));
+                while(q < eol && blank(*q)) ++q;
+            }
+            const string& key = words[0];
+            if(cubes && (key == ".i" || key == ".o" || key == ".ilb" || key == ".ob"))
+                return fail(key + " after the cubes");
+            if(key == ".i" || key == ".o"){
+                // 1..63 inputs, so that 1ULL << numberOfInputs is still defined
+                char* numberEnd = NULL;
+                long n = words.size() == 2 ? strtol(words[1].c_str(), &numberEnd, 10) : -1;
+                if(words.size() != 2 || numberEnd == words[1].c_str() || *numberEnd
+                    || (key == ".i" && (n < 1 || n > 63)) || (key == ".o" && (n < 1 || n > INT_MAX)))
+                    return fail("bad " + key);
+                (key == ".i" ? pla.numberOfInputs : pla.numberOfOutputs) = (int)n;
+            }else if(key == ".ilb")
+                pla.inputNames.assign(words.begin() + 1, words.end());
+            else if(key == ".ob")
+                pla.outputNames.assign(words.begin() + 1, words.end());
+            else if(key == ".type"){
+                if(words.size() != 2 || (words[1] != "f" && words[1] != "fd" && words[1] != "fr" && words[1] != "fdr"))
+                    return fail("unsupported .type");
+                pla.type = words[1];
+            }else if(key == ".e" || key == ".end")
+                break;
+            else if(key != ".p") // .p is only the number of cubes
+                return fail("unsupported directive " + key);
+            continue;
+        }
+
+        if(pla.numberOfInputs < 0 || pla.numberOfOutputs < 0)
+            return fail(".i and .o must come before the cubes");
+        if(!cubes){
+            cubes = true;
+            pla.onCubes.resize(pla.numberOfOutputs);
+            pla.dcCubes.resize(pla.numberOfOutputs);
+            pla.offCubes.resize(pla.numberOfOutputs);
+        }
+        ull bits = 0, ask = 0;
+        int n = 0;
+        for(; q < eol && n < pla.numberOfInputs; ++q){
+            if(blank(*q)) continue;
+            ull v = 1ULL << (pla.numberOfInputs - 1 - n);
+            if(*q == '1' || *q == '4') bits |= v;
+            else if(*q == '-' || *q == '2') ask |= v;
+            else if(*q != '0' && *q != '3')
+                return fail(string("bad input character '") + *q + "'");
+            ++n;
+        }
+        Cube cube(bits, ask);
+        int o = 0;
+        for(; q < eol; ++q){
+            if(blank(*q)) continue;
+            if(o == pla.numberOfOutputs)
+                return fail("more than .o output characters");
+            if(*q == '1' || *q == '4') pla.onCubes[o].push_back(cube);
+            else if(*q == '-' || *q == '2') pla.dcCubes[o].push_back(cube);
+            else if(*q == '0' || *q == '3') pla.offCubes[o].push_back(cube);
+            else if(*q != '~')
+                return fail(string("bad output character '") + *q + "'");
+            ++o;
+        }
+        if(n < pla.numberOfInputs || o < pla.numberOfOutputs)
+            return fail("cube has fewer than .i input and .o output characters");
+    }
+    if(pla.numberOfInputs < 0 || pla.numberOfOutputs < 0)
+        return fail("missing .i or .o");
+    if(pla.onCubes.empty()){ // No cubes
+        pla.onCubes.resize(pla.numberOfOutputs);
+        pla.dcCubes.resize(pla.numberOfOutputs);
+        pla.offCubes.resize(pla.numberOfOutputs);
+    }
+    if((!pla.inputNames.empty() && pla.inputNames.size() != pla.numberOfInputs)
+        || (!pla.outputNames.empty() && pla.outputNames.size() != pla.numberOfOutputs))
+        return fail(".ilb or .ob doesn't match .i or .o");
+    return true;
+}
+bool readPla(const string& path, PlaFile& pla, string& error){
+    ifstream file(path);
+    if(!file){
+        error = "cannot open " + path;
+        return false;
+    }
+    return readPla(file, pla, error);
+}
+#endif
@@ -0,0 +1,167 @@
+/*
+
+title: ResultCache.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include "Cube.h"
+using namespace std;
+
+typedef unsigned long long int ull;
+
+// LRU cache of covers that can be shared by many Tabular instances
+class ResultCache{
+public:
+    // 128 bit hash of the canonical function
+    struct Key{
+        ull h1, h2;
+        bool operator<(const Key& another)const{
+            return h1 != another.h1 ? h1 < another.h1 : h2 < another.h2;
+        }
+    };
+private:
+    struct Entry{
+        Key key;
+        vector<Cube> cover;
+    };
+    size_t capacity;
+    list<Entry> entries; // Most recently used first
+    map<Key, list<Entry>::iterator> index;
+    long long hits, misses;
+    static ull fmix(ull x);
+    static void add(Key& key, ull x);
+public:
+    ResultCache(size_t capacity=1024);
+    static Key makeKey(int numberOfInputs, int mode, vector<ull> ons, vector<ull> dcs, vector<Cube> dcCubes);
+    bool find(const Key& key, vector<Cube>& cover);
+    void insert(const Key& key, const vector<Cube>& cover);
+    void clear();
+    size_t size();
+    long long getHits();
+    long long getMisses();
+    bool load(const string& path);
+    bool save(const string& path);
+};
+
+ResultCache::ResultCache(size_t capacity){
+    this->capacity = max((size_t)1, capacity);
+    hits = misses = 0;
+}
+ull ResultCache::fmix(ull x){
+    x ^= x >> 33; x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+void ResultCache::add(Key& key, ull x){
+    // Two independent streams so that a collision needs both of them to collide
+    key.h1 = fmix(key.h1 ^ x) + 0x9e3779b97f4a7c15ULL;
+    key.h2 = (key.h2 ^ fmix(x ^ 0xc2b2ae3d27d4eb4fULL)) * 0x100000001b3ULL;
+}
+ResultCache::Key ResultCache::makeKey(int numberOfInputs, int mode, vector<ull> ons, vector<ull> dcs, vector<Cube> dcCubes){
+    // Sorted and deduplicated, minterm wins over don't care
+    sort(ons.begin(), ons.end());
+    ons.erase(unique(ons.begin(), ons.end()), ons.end());
+    sort(dcs.begin(), dcs.end());
+    dcs.erase(unique(dcs.begin(), dcs.end()), dcs.end());
+    vector<ull> onlyDcs;
+    set_difference(dcs.begin(), dcs.end(), ons.begin(), ons.end(), back_inserter(onlyDcs));
+    sort(dcCubes.begin(), dcCubes.end());
+    dcCubes.erase(unique(dcCubes.begin(), dcCubes.end()), dcCubes.end());
+
+    Key key = {0, 0};
+    add(key, numberOfInputs);
+    add(key, mode);
+    add(key, ons.size());
+    for(auto m: ons) add(key, m);
+    add(key, onlyDcs.size());
+    for(auto d: onlyDcs) add(key, d);
+    add(key, dcCubes.size());
+    for(auto& c: dcCubes){
+        add(key, c.bits);
+        add(key, c.ask);
+    }
+    return key;
+}
+bool ResultCache::find(const Key& key, vector<Cube>& cover){
+    auto it = index.find(key);
+    if(it == index.end()){
+        ++misses;
+        return false;
+    }
+    ++hits;
+    entries.splice(entries.begin(), entries, it->second);
+    cover = it->second->cover;
+    return true;
+}
+void ResultCache::insert(const Key& key, const vector<Cube>& cover){
+    auto it = index.find(key);
+    if(it != index.end()){
+        it->second->cover = cover;
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+    entries.push_front({key, cover});
+    index[key] = entries.begin();
+    if(entries.size() > capacity){
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+void ResultCache::clear(){
+    entries.clear();
+    index.clear();
+}
+size_t ResultCache::size(){
+    return entries.size();
+}
+long long ResultCache::getHits(){
+    return hits;
+}
+long long ResultCache::getMisses(){
+    return misses;
+}
+bool ResultCache::load(const string& path){
+    // Entries are merged into the cache, the least recently used one is read last
+    ifstream in(path);
+    string magic;
+    if(!(in >> magic) || magic != "tabular-cache")
+        return false;
+    vector<Entry> loaded;
+    Entry e;
+    size_t n;
+    while(in >> hex >> e.key.h1 >> e.key.h2 >> dec >> n){
+        e.cover.resize(n);
+        for(size_t i = 0; i < n; ++i)
+            in >> hex >> e.cover[i].bits >> e.cover[i].ask >> dec;
+        if(!in)
+            return false;
+        loaded.push_back(e);
+    }
+    for(int i = (int)loaded.size() - 1; i >= 0; --i)
+        if(index.find(loaded[i].key) == index.end())
+            insert(loaded[i].key, loaded[i].cover);
+    return true;
+}
+bool ResultCache::save(const string& path){
+    ofstream out(path);
+    if(!out)
+        return false;
+    out << "tabular-cache" << endl;
+    for(auto& e: entries){
+        out << hex << e.key.h1 << " " << e.key.h2 << dec << " " << e.cover.size();
+        for(auto& c: e.cover)
+            out << hex << " " << c.bits << " " << c.ask << dec;
+        out << endl;
+    }
+    return (bool)out;
+}
+#endif
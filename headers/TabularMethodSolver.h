@@ -4,6 +4,8 @@ title: TabularMethodSolver.h
 author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
 
 */
+#ifndef TABULAR_METHOD_SOLVER_H
+#define TABULAR_METHOD_SOLVER_H
 #include <iostream>
 #include <algorithm>
 #include <string>
@@ -13,12 +15,228 @@ author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
 #include <queue>
 #include <set>
 #include <map>
+#include <stdexcept>
+#include <chrono>
+#include <atomic>
+#include <memory>
+#include <future>
+#include <climits>
+#include <numeric>
 #include "MaxSegmentTree.h"
+#include "TruthTable.h"
+#include "Cube.h"
+#include "ResultCache.h"
+#include "NPTransform.h"
+#include "ThreadPool.h"
+#include "CoverFormatter.h"
 #define MAX_INPUTS 64
+#define MAX_OUTPUTS 64
+#define MAX_MEMO_MINTERMS 64 // Uncovered minterms are a mask of one word in the memoized solver
+#define MEMO_TABLE_SIZE (1 << 20) // Upper bound of the entries in the memoized solver
+#define AUTO_EXACT_MINTERMS 24 // AUTO: parts of the chart up to this many minterms go to the exact search
+#define MEMO_LOG_STATES 36 // log2 of branching^cost up to which the memoized search is run by AUTO and Petrick, about 2^18 states are met
 using namespace std;
 
 typedef unsigned long long int ull;
 
+enum SolveMode{ TRUE_SOLUTION, APPROXIMATION, HEURISTIC, ANYTIME, MEMOIZED, PETRICK, AUTO };
+enum SolveStatus{ SOLVED, MEMORY_LIMIT_EXCEEDED, CANCELLED };
+enum SolvePhase{ PHASE_QUEUED, PHASE_PI, PHASE_EPI, PHASE_COVER, PHASE_DONE };
+
+// Engine names of the command line, the server protocol and the test tools
+bool parseEngine(const string& engine, SolveMode& mode){
+    if(engine == "exact") mode = TRUE_SOLUTION;
+    else if(engine == "greedy") mode = APPROXIMATION;
+    else if(engine == "heuristic") mode = HEURISTIC;
+    else if(engine == "anytime") mode = ANYTIME;
+    else if(engine == "dp") mode = MEMOIZED;
+    else if(engine == "petrick") mode = PETRICK;
+    else if(engine == "auto") mode = AUTO;
+    else return false;
+    return true;
+}
+
+// Thrown by the phases when the memory limit set by Tabular::setMemoryLimit is exceeded
+struct MemoryLimitError: public runtime_error{
+    MemoryLimitError(): runtime_error("memory limit exceeded"){}
+};
+
+// Thrown by the phases when the solve is cancelled through its SolveControl
+struct SolveCancelled: public runtime_error{
+    SolveCancelled(): runtime_error("solve cancelled"){}
+};
+
+// Shared by a solve and its caller: cooperative cancellation and progress of the running phase
+struct SolveControl{
+    atomic<bool> cancelled;
+    atomic<int> phase; // SolvePhase
+    atomic<double> fraction; // Estimated done part of the phase, from 0 to 1
+    SolveControl(){
+        cancelled = false;
+        phase = PHASE_QUEUED;
+        fraction = 0;
+    }
+    void cancel(){
+        cancelled = true;
+    }
+    void report(SolvePhase phase, double fraction){
+        this->phase = phase;
+        this->fraction = fraction;
+    }
+};
+
+// Wall times (ns) of each phase and counters of the last solve
+struct SolveStats{
+    long long piTime, epiTime, graphTime, coverTime;
+    long long pairsCompared, merges, duplicatesRejected;
+    long long duplicateInputs, overlappingInputs; // Removed by preprocessing
+    long long searchNodes, prunes;
+    vector<long long> PIsPerLevel; // PIsPerLevel[i] = number of PIs with i '-'s
+    int numberOfPIs, numberOfEPIs;
+    int secondaryEPIs, dominatedPIs, dominatingMinterms; // Removed from the chart by reduceGraph
+    // AUTO: shape of the reduced chart and the weakest engine used on its parts, APPROXIMATION means the cover may not be minimum
+    int components, largestComponent; // largestComponent = minterms of the largest connected part
+    double density; // Edges / (PIs * minterms)
+    bool autoSelected;
+    SolveMode autoMode;
+    bool cacheHit; // The cover was taken from the ResultCache
+    bool timedOut; // The search stopped at the time limit, so the cover may not be minimum
+    // Estimated bytes of implicant storage, the chart and the search state (current and peak)
+    long long implicantBytes, chartBytes, searchBytes;
+    long long peakImplicantBytes, peakChartBytes, peakSearchBytes, peakTotalBytes;
+    SolveStats(){
+        piTime = epiTime = graphTime = coverTime = 0;
+        pairsCompared = merges = duplicatesRejected = 0;
+        duplicateInputs = overlappingInputs = 0;
+        searchNodes = prunes = 0;
+        numberOfPIs = numberOfEPIs = 0;
+        secondaryEPIs = dominatedPIs = dominatingMinterms = 0;
+        components = largestComponent = 0;
+        density = 0;
+        autoSelected = false;
+        autoMode = TRUE_SOLUTION;
+        cacheHit = timedOut = false;
+        implicantBytes = chartBytes = searchBytes = 0;
+        peakImplicantBytes = peakChartBytes = peakSearchBytes = peakTotalBytes = 0;
+    }
+    string toString() const{
+        string str = cacheHit ? "cache hit\n" : "";
+        str += "getPI " + to_string(piTime) + "ns, getEPI " + to_string(epiTime) + "ns, buildGraph " + to_string(graphTime)
+            + "ns, cover " + to_string(coverTime) + "ns\n";
+        str += "duplicated inputs " + to_string(duplicateInputs) + ", minterms also given as don't cares " + to_string(overlappingInputs) + "\n";
+        str += "pairs compared " + to_string(pairsCompared) + ", merges " + to_string(merges) + ", duplicates rejected "
+            + to_string(duplicatesRejected) + ", search nodes " + to_string(searchNodes) + ", prunes " + to_string(prunes) + "\n";
+        str += "PIs " + to_string(numberOfPIs) + " (per level:";
+        for(int i = 0; i < PIsPerLevel.size(); ++i)
+            str += " " + to_string(PIsPerLevel[i]);
+        str += "), EPIs " + to_string(numberOfEPIs) + "\n";
+        str += "chart reduction: secondary EPIs " + to_string(secondaryEPIs) + ", dominated PIs " + to_string(dominatedPIs)
+            + ", dominating minterms " + to_string(dominatingMinterms) + "\n";
+        if(autoSelected){
+            const char* names[] = {"exact", "greedy", "heuristic", "anytime", "dp", "petrick", "auto"};
+            str += "auto: " + string(names[autoMode]) + ", components " + to_string(components) + " (largest "
+                + to_string(largestComponent) + " minterms), density " + to_string(density) + "\n";
+        }
+        str += "peak bytes: implicants " + to_string(peakImplicantBytes) + ", chart " + to_string(peakChartBytes)
+            + ", search " + to_string(peakSearchBytes) + ", total " + to_string(peakTotalBytes);
+        return str;
+    }
+};
+
+// Stops a search at the deadline or on cancellation, checked once every 1024 nodes.
+// explored is the part of the search tree that is done, a node at depth d weighs 2^-d.
+struct SearchLimit{
+    chrono::steady_clock::time_point deadline;
+    bool hasDeadline;
+    SolveControl* control;
+    long long nodes;
+    bool expired, cancelled;
+    double explored;
+    SearchLimit(long long ms, SolveControl* control=NULL){
+        hasDeadline = ms >= 0;
+        deadline = chrono::steady_clock::now() + chrono::milliseconds(max(0LL, ms));
+        this->control = control;
+        nodes = 0;
+        expired = cancelled = false;
+        explored = 0;
+    }
+    bool check(){
+        if(!expired && (++nodes & 1023) == 0){
+            if(control){
+                cancelled = control->cancelled;
+                control->fraction = explored;
+            }
+            expired = cancelled || (hasDeadline && chrono::steady_clock::now() >= deadline);
+        }
+        return expired;
+    }
+};
+
+// Exact cover search where row i of the chart is a bitset of the minterms PI i covers
+struct CoverSearch{
+    int nL, nR, W; // W words per row
+    vector<ull> rows; // nL * W
+    vector<ull> covered; // (nL + 1) * W, covered[k] = minterms covered after taking k PIs
+    vector<ull> suffix; // (nL + 1) * W, suffix[i] = minterms covered by PIs i ... nL - 1
+    vector<ull> full;
+    vector<int> nowCase;
+    vector<int> order; // order[i] = row of G at position i, rows are sorted by their lowest minterm
+    vector<double> weight; // weight[d] = 2^-d, part of the search tree under a node at depth d
+    vector<int>* minCase;
+    int minCost;
+    SolveStats* stats;
+    SearchLimit* limit;
+    void init(vector<vector<int>>& G, int numberOfMinterms);
+    void search(int idx, int cost, int coveredCnt);
+};
+
+// Exact cover by memoization over the set of uncovered minterms, branching on the lowest one.
+// The table is bounded: once it is full, new states are recomputed instead of stored.
+struct MemoCover{
+    struct Entry{
+        ull mask; // 0 = empty slot
+        int cost, choice;
+    };
+    vector<ull> rows; // rows[p] = minterms PI p covers
+    vector<vector<int>>* GR;
+    vector<Entry> table;
+    size_t used;
+    SolveStats* stats;
+    SearchLimit* limit;
+    static size_t tableSize(size_t numberOfMinterms);
+    void init(vector<vector<int>>& GL, vector<vector<int>>& GR, size_t tableSize);
+    int solve(ull mask, int& choice);
+};
+
+// Minimum covers of a chart, found one at a time: the search keeps its stack between covers
+// and stops after limit covers. Covers are PI indices of the Tabular, EPIs included.
+class CoverStream{
+private:
+    int nL, W, target; // target = number of chart PIs in a minimum cover, -1 if there is none
+    vector<ull> rows, suffix, covered, full; // covered[d * W, (d + 1) * W) = covered by choice[0, d)
+    vector<int> choice, rev, fixed;
+    int depth;
+    size_t produced, limit;
+public:
+    class iterator{
+    private:
+        CoverStream* stream; // NULL at the end
+        vector<int> cover;
+    public:
+        iterator(CoverStream* stream);
+        const vector<int>& operator*() const;
+        const vector<int>* operator->() const;
+        iterator& operator++();
+        bool operator==(const iterator& another) const;
+        bool operator!=(const iterator& another) const;
+    };
+    CoverStream();
+    CoverStream(vector<vector<int>>& GL, int numberOfMinterms, vector<int>& rev, vector<int>& fixed, int minCost, size_t limit);
+    bool next(vector<int>& cover);
+    iterator begin();
+    iterator end();
+};
+
 class ImcntBits{
 private:
     ull bits;
@@ -27,7 +245,10 @@ private:
 public:
     ImcntBits();
     ImcntBits(int numberOfInputs, ull bits);
+    ImcntBits(int numberOfInputs, const Cube& cube);
     string toString();
+    int countDashes();
+    Cube toCube();
     int hammingDist(const ImcntBits& another);
     ImcntBits returnCombined(const ImcntBits& another);
     friend ImcntBits;
@@ -36,12 +257,14 @@ class Impcnt{
 private:
     vector<ull> terms;
     ImcntBits bits;
+    ull outputs;
     int numberOfInputs;
     bool check, isEPI;
 public:
     Impcnt(int numberOfInputs);
     Impcnt(int numberOfInputs, ull term);
     Impcnt(const vector<ull>& terms);
+    Impcnt(int numberOfInputs, const Cube& cube);
     ull getTerm(int idx);
     int getNumberOfTerms();
     void addTerm(ull term);
@@ -49,34 +272,114 @@ public:
     bool getCheck();
     void setEPI();
     bool getEPI();
+    void setOutputs(ull outputs);
+    ull getOutputs();
     void printTerms();
+    size_t memoryUsage();
     Impcnt returnCombined(const Impcnt& another);
     ImcntBits getBits();
+    Cube getCube();
     friend Impcnt;
 };
 class Tabular{
 private:
     vector<ull> minterms, dontcares;
+    vector<Cube> mintermCubes, dontcareCubes;
+    TruthTable onTable, dcTable;
     vector<Impcnt> PIs;
     int numberOfInputs, totNumberOfEPI;
+    bool dense, fixedInputs, reduction;
+    SolveStats stats;
+    SolveStatus status;
+    size_t memoryLimit;
+    ResultCache* cache;
+    bool canonical;
+    size_t candidateLimit;
+    long long timeLimit;
+    shared_ptr<SolveControl> control;
+    vector<string> inputNames;
+    string outputName;
+    CoverFormat outputFormat;
+    void progress(SolvePhase phase, double fraction);
+    static long long elapsed(chrono::steady_clock::time_point begin);
+    void useMemory(long long& current, long long& peak, long long bytes);
+    vector<int> runSolve(SolveMode mode, bool showProcess);
+    vector<int> runCached(SolveMode mode, bool showProcess);
+    void fitInputs(ull used);
     void addMin(ull m);
     void addDon(ull d);
-    int countBit(ull b);
+    void addMinCube(const Cube& c);
+    void addDonCube(const Cube& c);
+    void preprocess();
+    static void sortCubes(vector<Cube>& cubes, vector<Cube>& buffer, int numberOfInputs);
+    ull inputMask();
+    void coverExact(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& solCase);
+    vector<vector<int>> petrickCovers(bool all);
+    void reduceGraph(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& rev, vector<int>& forced, bool keepCovers=false);
+    static bool memoFits(vector<vector<int>>& GL, int numberOfMinterms, int cost);
+    static Cube parseCube(const string& str);
+    void collectMinterms(vector<ull>& ons);
+    void collectDontcareCover(vector<Cube>& dc);
+    void expandTables();
+    long long denseBytes();
+    void getPIFromMinterms();
+    void getPIFromCubes();
+    void getPIDense();
+    void densePrimes(vector<vector<ull>>& C, vector<vector<size_t>>& nonzero, int depth, ull mask, const TruthTable& on, vector<ull>& masks);
+    static bool tautology(vector<Cube>& cover, ull freeMask);
+    bool coversCube(const vector<Cube>& cover, const Cube& c);
+    void expand(vector<Cube>& F, const vector<Cube>& care);
+    void irredundant(vector<Cube>& F, const vector<Cube>& dc);
+    void reduce(vector<Cube>& F, const vector<Cube>& dc);
 public:
     Tabular();
+    Tabular(int numberOfInputs);
     Tabular(vector<ull>& mins, vector<ull>& donts);
+    Tabular(int numberOfInputs, vector<ull>& mins, vector<ull>& donts);
+    Tabular(const TruthTable& on, const TruthTable& dc);
+    void setDense(bool dense);
+    void setReduction(bool reduction);
+    void setMemoryLimit(size_t bytes);
+    void setCache(ResultCache* cache);
+    void setCanonical(bool canonical, size_t candidateLimit=720);
+    void setTimeLimit(long long ms);
+    void setControl(shared_ptr<SolveControl> control);
+    void setInputNames(const vector<string>& names);
+    void setOutputName(const string& name);
+    void setOutputFormat(CoverFormat format);
     void addMinterm(ull m);
     void addDontcare(ull d);
+    void addMintermCube(ull bits, ull ask);
+    void addMintermCube(const string& cube);
+    void addDontcareCube(ull bits, ull ask);
+    void addDontcareCube(const string& cube);
     void getPI();
     void getEPI();
     void buildGraph(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& rev);
-    void bruteForce(vector<vector<int>>& G, vector<int>& selected, vector<int>& nowCase, vector<int>& minCase, int selCnt, int idx, int cost, int& minCost);
-    void greedy(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& minCase);
+    static void sharp(const Cube& a, const Cube& b, vector<Cube>& out);
+    static void bruteForce(vector<vector<int>>& G, int numberOfMinterms, vector<int>& minCase, int& minCost, SolveStats* stats=NULL, SearchLimit* limit=NULL);
+    static void memoizedCover(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& minCase, SolveStats* stats=NULL, SearchLimit* limit=NULL);
+    static void petrick(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<vector<int>>& covers, SolveStats* stats=NULL, SearchLimit* limit=NULL, int minCost=-1);
+    static int minimumCost(vector<vector<int>>& GL, vector<vector<int>>& GR, SearchLimit* limit=NULL);
+    static void greedy(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& minCase, SolveControl* control=NULL);
     vector<int> approximationSolver();
     vector<int> trueSolver();
-    string ansToString(vector<int> ans);
+    vector<int> anytimeSolver();
+    vector<int> memoizedSolver();
+    vector<int> petrickSolver();
+    vector<int> autoSolver();
+    vector<int> heuristicSolver();
+    string ansToString(const vector<int>& ans);
     string solve(bool approx, bool showProcess=false);
+    string solve(SolveMode mode, bool showProcess=false);
+    vector<string> allMinimumSolutions();
+    CoverStream minimumCovers(size_t limit=SIZE_MAX);
     int solveTest(bool approx);
+    int solveTest(SolveMode mode);
+    future<string> solveAsync(SolveMode mode, shared_ptr<SolveControl> control=NULL, ThreadPool* executor=NULL);
+    int getNumberOfEPIs();
+    const SolveStats& getStats();
+    SolveStatus getStatus();
 };
 struct segNode{
     int value, idx;
@@ -110,6 +413,13 @@ ImcntBits::ImcntBits(int numberOfInputs, ull bits){
     this->bits = bits;
     ask.resize(numberOfInputs, false);
 }
+ImcntBits::ImcntBits(int numberOfInputs, const Cube& cube){
+    this->numberOfInputs = numberOfInputs;
+    this->bits = cube.bits;
+    ask.resize(numberOfInputs, false);
+    for(int i = 0; i < numberOfInputs; ++i)
+        ask[i] = cube.ask >> i & 1;
+}
 string ImcntBits::toString(){
     string str = "";
     stack<char> stk;
@@ -126,6 +436,18 @@ string ImcntBits::toString(){
     }
     return str;
 }
+int ImcntBits::countDashes(){
+    int cnt = 0;
+    for(int i = 0; i < numberOfInputs; ++i)
+        cnt += ask[i];
+    return cnt;
+}
+Cube ImcntBits::toCube(){
+    ull mask = 0;
+    for(int i = 0; i < numberOfInputs; ++i)
+        if(ask[i]) mask |= 1ULL << i;
+    return Cube(bits, mask);
+}
 int ImcntBits::hammingDist(const ImcntBits& another){
     int dist = 0;
     ull diff = bits ^ another.bits;
@@ -150,6 +472,7 @@ ImcntBits ImcntBits::returnCombined(const ImcntBits& another){
 
 Impcnt::Impcnt(int numberOfInputs){
     this->numberOfInputs = numberOfInputs;
+    outputs = 1;
     check = false;
     isEPI = false;
 }
@@ -157,12 +480,21 @@ Impcnt::Impcnt(int numberOfInputs, ull term){
     this->numberOfInputs = numberOfInputs;
     bits = ImcntBits(numberOfInputs, term);
     terms.push_back(term);
+    outputs = 1;
     check = false;
     isEPI = false;
 }
 Impcnt::Impcnt(const vector<ull>& terms){
     for(auto t: terms)
         this->terms.push_back(t);
+    outputs = 1;
+    check = false;
+    isEPI = false;
+}
+Impcnt::Impcnt(int numberOfInputs, const Cube& cube){
+    this->numberOfInputs = numberOfInputs;
+    bits = ImcntBits(numberOfInputs, cube);
+    outputs = 1;
     check = false;
     isEPI = false;
 }
@@ -187,6 +519,12 @@ void Impcnt::setEPI(){
 bool Impcnt::getEPI(){
     return isEPI;
 }
+void Impcnt::setOutputs(ull outputs){
+    this->outputs = outputs;
+}
+ull Impcnt::getOutputs(){
+    return outputs;
+}
 void Impcnt::printTerms(){
     cout << "{";
     for(int i = 0; i < terms.size(); ++i){
@@ -210,117 +548,954 @@ Impcnt Impcnt::returnCombined(const Impcnt& another){
             ret.addTerm(another.terms[j++]);
     }
     ret.bits = bits.returnCombined(another.bits);
+    ret.outputs = outputs & another.outputs;
     return ret;
 }
+size_t Impcnt::memoryUsage(){
+    return sizeof(Impcnt) + terms.capacity() * sizeof(ull) + (numberOfInputs + 7) / 8;
+}
 ImcntBits Impcnt::getBits(){
     return bits;
 }
+Cube Impcnt::getCube(){
+    return bits.toCube();
+}
 
+void Tabular::fitInputs(ull used){
+    // Number of inputs is either given up front or grown to the highest bit in use
+    int width = used ? 64 - __builtin_clzll(used) : 0;
+    if(fixedInputs){
+        if(width > numberOfInputs)
+            throw out_of_range("term uses more inputs than the function has");
+        return;
+    }
+    numberOfInputs = max(numberOfInputs, width);
+}
 void Tabular::addMin(ull m){
+    fitInputs(m);
     minterms.push_back(m);
-    numberOfInputs = max(numberOfInputs, (int)log2(m) + 1);
 }
 void Tabular::addDon(ull d){
+    fitInputs(d);
     dontcares.push_back(d);
-    numberOfInputs = max(numberOfInputs, (int)log2(d) + 1);
 }
-int Tabular::countBit(ull b){
-    int cnt = 0;
-    for(; b; b >>= 1) cnt += (b & 1);
-    return cnt;
+void Tabular::addMinCube(const Cube& c){
+    fitInputs(c.bits | c.ask);
+    mintermCubes.push_back(c);
+}
+void Tabular::addDonCube(const Cube& c){
+    fitInputs(c.bits | c.ask);
+    dontcareCubes.push_back(c);
+}
+Cube Tabular::parseCube(const string& str){
+    // Same order as ImcntBits::toString, the first character is the most significant bit
+    if(str.size() > MAX_INPUTS)
+        throw invalid_argument("cube is wider than MAX_INPUTS");
+    ull bits = 0, ask = 0;
+    for(int i = 0, n = str.size(); i < n; ++i){
+        ull b = 1ULL << (n - 1 - i);
+        if(str[i] == '1')
+            bits |= b;
+        else if(str[i] == '-')
+            ask |= b;
+    }
+    return Cube(bits, ask);
+}
+void Tabular::sharp(const Cube& a, const Cube& b, vector<Cube>& out){
+    // Disjoint sharp: pieces of a that are outside of b
+    if(!a.intersects(b)){
+        out.push_back(a);
+        return;
+    }
+    Cube rest = a;
+    for(ull t = a.ask & ~b.ask; t; t &= t - 1){
+        ull v = t & -t;
+        out.push_back(Cube(rest.bits | (~b.bits & v), rest.ask & ~v));
+        rest = Cube(rest.bits | (b.bits & v), rest.ask & ~v);
+    }
+}
+void Tabular::collectMinterms(vector<ull>& ons){
+    ons = minterms;
+    onTable.getPoints(ons);
+    for(int i = 0; i < mintermCubes.size(); ++i){
+        ull ask = mintermCubes[i].ask;
+        for(ull t = ask; ; t = (t - 1) & ask){
+            ons.push_back(mintermCubes[i].bits | t);
+            if(!t) break;
+        }
+    }
+}
+void Tabular::collectDontcareCover(vector<Cube>& dc){
+    // Minterm wins over don't care, so overlapping parts are removed from the don't care cover
+    vector<ull> sortedMins(minterms);
+    sort(sortedMins.begin(), sortedMins.end());
+    for(int i = 0; i < dontcares.size(); ++i){
+        Cube d(dontcares[i], 0);
+        bool overlapped = binary_search(sortedMins.begin(), sortedMins.end(), dontcares[i]);
+        for(int j = 0; j < mintermCubes.size() && !overlapped; ++j)
+            overlapped = mintermCubes[j].contains(d);
+        if(!overlapped)
+            dc.push_back(d);
+    }
+    for(int i = 0; i < dontcareCubes.size(); ++i){
+        vector<Cube> pieces(1, dontcareCubes[i]);
+        for(int j = 0; j < minterms.size() + mintermCubes.size(); ++j){
+            Cube on = j < minterms.size() ? Cube(minterms[j], 0) : mintermCubes[j - minterms.size()];
+            vector<Cube> nPieces;
+            for(int k = 0; k < pieces.size(); ++k)
+                sharp(pieces[k], on, nPieces);
+            pieces.swap(nPieces);
+        }
+        dc.insert(dc.end(), pieces.begin(), pieces.end());
+    }
+    vector<ull> points;
+    dcTable.getPoints(points);
+    for(int i = 0; i < points.size(); ++i)
+        if(onTable.empty() || !onTable.get(points[i]))
+            dc.push_back(Cube(points[i], 0));
+}
+void Tabular::expandTables(){
+    // Points of the truth tables are moved to the lists, for the paths that don't read the bitmaps
+    onTable.getPoints(minterms);
+    dcTable.getPoints(dontcares);
+    onTable = dcTable = TruthTable();
+}
+long long Tabular::denseBytes(){
+    // getPIDense keeps a bitmap and the indices of its nonzero words for every depth of the walk, with the ON
+    // and care bitmaps
+    long long words = numberOfInputs > 6 ? 1LL << (numberOfInputs - 6) : 1;
+    return (numberOfInputs + 3) * (words * (long long)(sizeof(ull) + sizeof(size_t)) + 64);
+}
+long long Tabular::elapsed(chrono::steady_clock::time_point begin){
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count();
+}
+void Tabular::useMemory(long long& current, long long& peak, long long bytes){
+    current = bytes;
+    peak = max(peak, bytes);
+    long long total = stats.implicantBytes + stats.chartBytes + stats.searchBytes;
+    stats.peakTotalBytes = max(stats.peakTotalBytes, total);
+    if(memoryLimit && total > memoryLimit)
+        throw MemoryLimitError();
+}
+void Tabular::preprocess(){
+    // Duplicated terms are removed and a minterm wins over a don't care
+    size_t inputs = minterms.size() + dontcares.size();
+    sort(minterms.begin(), minterms.end());
+    minterms.erase(unique(minterms.begin(), minterms.end()), minterms.end());
+    sort(dontcares.begin(), dontcares.end());
+    dontcares.erase(unique(dontcares.begin(), dontcares.end()), dontcares.end());
+    stats.duplicateInputs = inputs - minterms.size() - dontcares.size();
+    vector<ull> onlyDontcares;
+    set_difference(dontcares.begin(), dontcares.end(), minterms.begin(), minterms.end(), back_inserter(onlyDontcares));
+    stats.overlappingInputs = dontcares.size() - onlyDontcares.size();
+    dontcares.swap(onlyDontcares);
 }
 Tabular::Tabular(){
     numberOfInputs = 0;
+    dense = false;
+    fixedInputs = false;
+    status = SOLVED;
+    memoryLimit = 0;
+    cache = NULL;
+    canonical = false;
+    candidateLimit = 720;
+    timeLimit = 1000;
+    reduction = true;
+    outputFormat = FORMAT_EQUATION;
+}
+Tabular::Tabular(int numberOfInputs){
+    if(numberOfInputs < 0 || numberOfInputs > MAX_INPUTS)
+        throw invalid_argument("number of inputs must be in [0, MAX_INPUTS]");
+    this->numberOfInputs = numberOfInputs;
+    dense = false;
+    fixedInputs = true;
+    status = SOLVED;
+    memoryLimit = 0;
+    cache = NULL;
+    canonical = false;
+    candidateLimit = 720;
+    timeLimit = 1000;
+    reduction = true;
+    outputFormat = FORMAT_EQUATION;
 }
 Tabular::Tabular(vector<ull>& mins, vector<ull>& donts){
     numberOfInputs = 0;
+    dense = false;
+    fixedInputs = false;
+    status = SOLVED;
+    memoryLimit = 0;
+    cache = NULL;
+    canonical = false;
+    candidateLimit = 720;
+    timeLimit = 1000;
+    reduction = true;
+    outputFormat = FORMAT_EQUATION;
+    minterms.reserve(mins.size());
+    dontcares.reserve(donts.size());
     for(auto m: mins)
         addMin(m);
     for(auto d: donts)
         addDon(d);
 }
+Tabular::Tabular(int numberOfInputs, vector<ull>& mins, vector<ull>& donts): Tabular(numberOfInputs){
+    minterms.reserve(mins.size());
+    dontcares.reserve(donts.size());
+    for(auto m: mins)
+        addMin(m);
+    for(auto d: donts)
+        addDon(d);
+}
+Tabular::Tabular(const TruthTable& on, const TruthTable& dc){
+    numberOfInputs = max(on.getNumberOfInputs(), dc.getNumberOfInputs());
+    onTable = on;
+    dcTable = dc;
+    dense = true;
+    fixedInputs = true;
+    status = SOLVED;
+    memoryLimit = 0;
+    cache = NULL;
+    canonical = false;
+    candidateLimit = 720;
+    timeLimit = 1000;
+    reduction = true;
+    outputFormat = FORMAT_EQUATION;
+}
+void Tabular::setDense(bool dense){
+    this->dense = dense;
+}
+void Tabular::setReduction(bool reduction){
+    this->reduction = reduction;
+}
+void Tabular::setMemoryLimit(size_t bytes){
+    memoryLimit = bytes;
+}
+void Tabular::setCache(ResultCache* cache){
+    this->cache = cache;
+}
+void Tabular::setCanonical(bool canonical, size_t candidateLimit){
+    this->canonical = canonical;
+    this->candidateLimit = candidateLimit;
+}
+void Tabular::setTimeLimit(long long ms){
+    timeLimit = ms;
+}
+void Tabular::setControl(shared_ptr<SolveControl> control){
+    this->control = control;
+}
+void Tabular::setInputNames(const vector<string>& names){
+    inputNames = names;
+}
+void Tabular::setOutputName(const string& name){
+    outputName = name;
+}
+void Tabular::setOutputFormat(CoverFormat format){
+    outputFormat = format;
+}
+void Tabular::progress(SolvePhase phase, double fraction){
+    // Check point of the cooperative cancellation
+    if(control == NULL)
+        return;
+    if(control->cancelled)
+        throw SolveCancelled();
+    control->report(phase, fraction);
+}
 void Tabular::addMinterm(ull m){
     addMin(m);
 }
 void Tabular::addDontcare(ull d){
     addDon(d);
 }
-void Tabular::getPI(){
-    vector<vector<vector<Impcnt>>> lists;
-    vector<vector<Impcnt>> firstList(numberOfInputs + 1);
+void Tabular::addMintermCube(ull bits, ull ask){
+    addMinCube(Cube(bits, ask));
+}
+void Tabular::addMintermCube(const string& cube){
+    Cube c = parseCube(cube);
+    if(!cube.empty())
+        fitInputs(1ULL << (cube.size() - 1)); // Leading '0's count as inputs too
+    addMinCube(c);
+}
+void Tabular::addDontcareCube(ull bits, ull ask){
+    addDonCube(Cube(bits, ask));
+}
+void Tabular::addDontcareCube(const string& cube){
+    Cube c = parseCube(cube);
+    if(!cube.empty())
+        fitInputs(1ULL << (cube.size() - 1));
+    addDonCube(c);
+}
+void Tabular::getPIFromCubes(){
+    // Iterated consensus: PIs are generated from the given cubes without expanding them to minterms
+    vector<Cube> cubes(mintermCubes);
+    cubes.insert(cubes.end(), dontcareCubes.begin(), dontcareCubes.end());
     for(int i = 0; i < minterms.size(); ++i)
-        firstList[countBit(minterms[i])].push_back(Impcnt(numberOfInputs, minterms[i]));
+        cubes.push_back(Cube(minterms[i], 0));
     for(int i = 0; i < dontcares.size(); ++i)
-        firstList[countBit(dontcares[i])].push_back(Impcnt(numberOfInputs, dontcares[i]));
-    lists.push_back(firstList);
-    for(int i = 1; ; ++i){
-        vector<vector<Impcnt>> nList(numberOfInputs + 1);
-        vector<vector<Impcnt>>& lList = lists.back();
-
-        bool changed = false;
-        
-        for(int j = 0; j < numberOfInputs; ++j){ // Number of nums
-            set<string> duplicates;
-            for(int l = 0; l < lList[j].size(); ++l){
-                for(int n = 0; n < lList[j + 1].size(); ++n){
-                    int dist = lList[j][l].getBits().hammingDist(lList[j + 1][n].getBits());
-                    if(dist == 1){ // Combine
-                        lList[j][l].setCheck();
-                        lList[j + 1][n].setCheck();
-
-                        Impcnt newCircle = lList[j][l].returnCombined(lList[j + 1][n]);
-                        string hash = newCircle.getBits().toString();
-                        if(duplicates.find(hash) == duplicates.end()){
-                            duplicates.insert(hash);
-
-                            nList[j].push_back(newCircle);
-                            changed = true;
-                        }
-                    }
+        cubes.push_back(Cube(dontcares[i], 0));
+
+    // Single cube containment
+    sort(cubes.begin(), cubes.end(), [](const Cube& a, const Cube& b){
+        return __builtin_popcountll(a.ask) > __builtin_popcountll(b.ask);
+    });
+    vector<Cube> primes;
+    for(int i = 0; i < cubes.size(); ++i){
+        bool contained = false;
+        for(int j = 0; j < primes.size() && !contained; ++j)
+            contained = primes[j].contains(cubes[i]);
+        if(!contained)
+            primes.push_back(cubes[i]);
+    }
+
+    for(bool changed = true; changed; ){
+        changed = false;
+        vector<bool> alive(primes.size(), true);
+        for(int i = 0; i < primes.size(); ++i){
+            progress(PHASE_PI, 0);
+            for(int j = i + 1; j < primes.size() && alive[i]; ++j){
+                if(!alive[j]) continue;
+                ++stats.pairsCompared;
+                ull conflict = (primes[i].bits ^ primes[j].bits) & ~primes[i].ask & ~primes[j].ask;
+                if(__builtin_popcountll(conflict) != 1) continue;
+                Cube consensus(((primes[i].bits & ~primes[i].ask) | (primes[j].bits & ~primes[j].ask)) & ~conflict,
+                               (primes[i].ask & primes[j].ask) | conflict);
+                bool contained = false;
+                for(int k = 0; k < primes.size() && !contained; ++k)
+                    contained = alive[k] && primes[k].contains(consensus);
+                if(contained){
+                    ++stats.duplicatesRejected;
+                    continue;
                 }
+                ++stats.merges;
+                for(int k = 0; k < primes.size(); ++k)
+                    if(alive[k] && consensus.contains(primes[k]))
+                        alive[k] = false;
+                primes.push_back(consensus);
+                alive.push_back(true);
+                changed = true;
+                useMemory(stats.implicantBytes, stats.peakImplicantBytes,
+                          (cubes.capacity() + primes.capacity()) * sizeof(Cube) + alive.capacity() / 8);
             }
         }
-        if(!changed)
-            break;
-        lists.push_back(nList);
+        vector<Cube> nPrimes;
+        for(int i = 0; i < primes.size(); ++i)
+            if(alive[i])
+                nPrimes.push_back(primes[i]);
+        primes.swap(nPrimes);
+    }
+    sort(primes.begin(), primes.end(), [](const Cube& a, const Cube& b){
+        int sa = __builtin_popcountll(a.ask), sb = __builtin_popcountll(b.ask);
+        if(sa != sb) return sa < sb;
+        return a.ask != b.ask ? a.ask < b.ask : a.bits < b.bits;
+    });
+
+    // Only minterms are needed as columns of the chart
+    vector<ull> ons;
+    collectMinterms(ons);
+    sort(ons.begin(), ons.end());
+    ons.erase(unique(ons.begin(), ons.end()), ons.end());
+    PIs.clear();
+    for(int i = 0; i < primes.size(); ++i){
+        Impcnt imp(numberOfInputs, primes[i]);
+        for(int j = 0; j < ons.size(); ++j)
+            if(primes[i].contains(Cube(ons[j], 0)))
+                imp.addTerm(ons[j]);
+        if(imp.getNumberOfTerms()) // PIs covering only don't cares are useless
+            PIs.push_back(imp);
+    }
+}
+void Tabular::getPI(){
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    stats.pairsCompared = stats.merges = stats.duplicatesRejected = 0;
+    progress(PHASE_PI, 0);
+    // The dense path is only taken when its bitmaps fit, the list path is bounded by the function instead
+    bool useDense = dense && numberOfInputs <= MAX_DENSE_INPUTS && denseBytes() <= (memoryLimit ? (long long)memoryLimit : MAX_DENSE_BYTES);
+    if(!useDense)
+        expandTables();
+    preprocess();
+    if(useDense)
+        getPIDense();
+    else if(!mintermCubes.empty() || !dontcareCubes.empty())
+        getPIFromCubes();
+    else
+        getPIFromMinterms();
+    stats.PIsPerLevel.assign(numberOfInputs + 1, 0);
+    for(int i = 0; i < PIs.size(); ++i)
+        ++stats.PIsPerLevel[PIs[i].getBits().countDashes()];
+    stats.numberOfPIs = PIs.size();
+    long long piBytes = 0;
+    for(int i = 0; i < PIs.size(); ++i)
+        piBytes += PIs[i].memoryUsage();
+    useMemory(stats.implicantBytes, stats.peakImplicantBytes, piBytes); // Levels are released here
+    stats.piTime = elapsed(begin);
+}
+void Tabular::sortCubes(vector<Cube>& cubes, vector<Cube>& buffer, int numberOfInputs){
+    // LSD radix sort by (ask, bits) on 8 bit digits, so cubes with the same '-' positions are contiguous.
+    // Digits of bits go first, passes where every cube has the same digit are skipped.
+    buffer.resize(cubes.size());
+    int digits = (numberOfInputs + 7) / 8;
+    for(int d = 0; d < 2 * digits; ++d){
+        int shift = d % digits * 8;
+        bool ofAsk = d >= digits;
+        size_t count[257] = {0};
+        for(size_t i = 0; i < cubes.size(); ++i)
+            ++count[((ofAsk ? cubes[i].ask : cubes[i].bits) >> shift & 255) + 1];
+        if(count[((ofAsk ? cubes[0].ask : cubes[0].bits) >> shift & 255) + 1] == cubes.size())
+            continue;
+        for(int k = 0; k < 256; ++k)
+            count[k + 1] += count[k];
+        for(size_t i = 0; i < cubes.size(); ++i)
+            buffer[count[(ofAsk ? cubes[i].ask : cubes[i].bits) >> shift & 255]++] = cubes[i];
+        cubes.swap(buffer);
     }
+}
+void Tabular::getPIFromMinterms(){
+    // Every level is a flat array sorted by (ask, bits) without duplicates. Cubes only combine when their
+    // '-' positions are the same, so the partner of a cube is looked up by binary search in its own run.
+    vector<Cube> level, next, buffer;
+    level.reserve(minterms.size() + dontcares.size());
+    for(size_t i = 0, j = 0; i < minterms.size() || j < dontcares.size(); ) // Both are sorted by preprocess()
+        if(j == dontcares.size() || (i < minterms.size() && minterms[i] < dontcares[j]))
+            level.push_back(Cube(minterms[i++], 0));
+        else
+            level.push_back(Cube(dontcares[j++], 0));
+    vector<bool> checked;
     PIs.clear();
-    for(int i = 0; i < lists.size(); ++i)
-        for(int j = 0; j <= numberOfInputs - i; ++j)
-            for(int k = 0; k < lists[i][j].size(); ++k)
-                if(!lists[i][j][k].getCheck())
-                    PIs.push_back(lists[i][j][k]);
-}
-void Tabular::bruteForce(vector<vector<int>>& G, vector<int>& selected, vector<int>& nowCase, vector<int>& minCase , int selCnt, int idx, int cost, int& minCost){
-    if(idx == G.size() || (minCost != -1 && minCost <= cost))
+    long long piBytes = 0;
+    ull full = inputMask();
+    // Checked as next grows too, since a level can be many times larger than the one before it
+    auto account = [&](size_t nextCapacity, size_t bufferCapacity){
+        useMemory(stats.implicantBytes, stats.peakImplicantBytes,
+                  (long long)(level.capacity() + nextCapacity + bufferCapacity) * sizeof(Cube) + checked.capacity() / 8 + piBytes);
+    };
+    for(int i = 0; !level.empty(); ++i){
+        progress(PHASE_PI, (double)i / max(1, numberOfInputs));
+        checked.assign(level.size(), false);
+        next.clear();
+        for(size_t start = 0, end; start < level.size(); start = end){
+            ull ask = level[start].ask;
+            for(end = start; end < level.size() && level[end].ask == ask; ++end);
+            for(size_t l = start; l < end; ++l){
+                // The partner differs in one free bit that is 0 here, so it comes later in the run
+                for(ull t = full & ~ask & ~level[l].bits; t; t &= t - 1){
+                    ull v = t & -t;
+                    ++stats.pairsCompared;
+                    Cube partner(level[l].bits | v, ask);
+                    size_t n = lower_bound(level.begin() + l + 1, level.begin() + end, partner) - level.begin();
+                    if(n == end || !(level[n] == partner)) continue;
+                    checked[l] = checked[n] = true;
+                    ++stats.merges;
+                    if(next.size() == next.capacity()) // Before the reallocation, which doubles it
+                        account(max((size_t)1, 2 * next.capacity()), buffer.capacity());
+                    next.push_back(Cube(level[l].bits, ask | v));
+                }
+            }
+        }
+        // A cube with k '-'s is made from k different runs, only one is kept
+        if(!next.empty()){
+            account(next.capacity(), max(buffer.capacity(), next.size()));
+            sortCubes(next, buffer, numberOfInputs);
+            size_t before = next.size();
+            next.erase(unique(next.begin(), next.end()), next.end());
+            stats.duplicatesRejected += before - next.size();
+        }
+
+        // Every combination with this level is known now, so its unchecked cubes are PIs
+        for(size_t k = 0; k < level.size(); ++k){
+            if(checked[k]) continue;
+            Impcnt imp(numberOfInputs, level[k]);
+            for(ull t = 0; ; t = (t - level[k].ask) & level[k].ask){ // Points of the cube in increasing order
+                imp.addTerm(level[k].bits | t);
+                if(t == level[k].ask) break;
+            }
+            piBytes += imp.memoryUsage();
+            PIs.push_back(imp);
+        }
+        account(next.capacity(), buffer.capacity());
+        level.swap(next);
+    }
+}
+void Tabular::getPIDense(){
+    // ON and don't care sets as bitmaps over the whole input space
+    TruthTable on = onTable, care(numberOfInputs);
+    if(on.getWords().size() != care.getWords().size()){
+        on = TruthTable(numberOfInputs);
+        vector<ull> points;
+        onTable.getPoints(points);
+        for(int i = 0; i < points.size(); ++i)
+            on.set(points[i]);
+    }
+    vector<ull> ons;
+    collectMinterms(ons);
+    for(int i = 0; i < ons.size(); ++i)
+        on.set(ons[i]);
+    vector<Cube> dcCover;
+    collectDontcareCover(dcCover);
+    care.getWords() = on.getWords();
+    for(int i = 0; i < dcCover.size(); ++i){
+        ull ask = dcCover[i].ask;
+        for(ull t = ask; ; t = (t - 1) & ask){
+            care.set(dcCover[i].bits | t);
+            if(!t) break;
+        }
+    }
+
+    // C[mask][x] = 1 iff the cube made by replacing the bits of mask in x by '-' is in ON + DC.
+    // Masks are visited depth first, each one from mask without its highest bit, so only the bitmaps
+    // on the path are kept
+    size_t words = care.getWords().size();
+    vector<vector<ull>> C(numberOfInputs + 1, vector<ull>(words, 0));
+    vector<vector<size_t>> nonzero(numberOfInputs + 1);
+    C[0] = care.getWords();
+    for(size_t w = 0; w < words; ++w)
+        if(C[0][w])
+            nonzero[0].push_back(w);
+    useMemory(stats.implicantBytes, stats.peakImplicantBytes, denseBytes());
+    PIs.clear();
+    vector<ull> masks;
+    if(!nonzero[0].empty())
+        densePrimes(C, nonzero, 0, 0, on, masks);
+
+    // Same order as the levels of the list path: by the number of '-', then by their positions
+    vector<int> order(PIs.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b){
+        int da = __builtin_popcountll(masks[a]), db = __builtin_popcountll(masks[b]);
+        return da != db ? da < db : masks[a] < masks[b];
+    });
+    vector<Impcnt> sorted;
+    sorted.reserve(PIs.size());
+    for(int i = 0; i < order.size(); ++i)
+        sorted.push_back(move(PIs[order[i]]));
+    PIs.swap(sorted);
+}
+void Tabular::densePrimes(vector<vector<ull>>& C, vector<vector<size_t>>& nonzero, int depth, ull mask, const TruthTable& on, vector<ull>& masks){
+    // C[mask | i] = C[mask] & C[mask] flipped along variable i, so (x, mask) is prime iff C[mask] has x
+    // and none of its flips along the other variables does. Only the nonzero words of C[mask] are read
+    progress(PHASE_PI, (double)depth / max(1, numberOfInputs));
+    vector<ull>& cur = C[depth];
+    vector<size_t>& words = nonzero[depth];
+    for(size_t j = 0; j < words.size(); ++j){
+        size_t w = words[j];
+        ull prime = cur[w];
+        for(int i = 0; i < numberOfInputs && prime; ++i)
+            if(!(mask >> i & 1))
+                prime &= ~TruthTable::flipWord(cur, w, i);
+        for(ull t = prime; t; t &= t - 1){
+            ull x = (w << 6) | __builtin_ctzll(t);
+            if(x & mask) continue; // Representative of the cube only
+            Impcnt imp(numberOfInputs, Cube(x, mask));
+            for(ull s = mask; ; s = (s - 1) & mask){
+                if(on.get(x | s))
+                    imp.addTerm(x | s);
+                if(!s) break;
+            }
+            if(imp.getNumberOfTerms()){ // PIs covering only don't cares are useless
+                PIs.push_back(imp);
+                masks.push_back(mask);
+            }
+        }
+    }
+    int from = mask ? 64 - __builtin_clzll(mask) : 0;
+    for(int i = from; i < numberOfInputs; ++i){
+        vector<ull>& next = C[depth + 1];
+        vector<size_t>& nextWords = nonzero[depth + 1];
+        nextWords.clear();
+        for(size_t j = 0; j < words.size(); ++j){
+            size_t w = words[j];
+            ull v = cur[w] & TruthTable::flipWord(cur, w, i);
+            if(v){
+                next[w] = v;
+                nextWords.push_back(w);
+            }
+        }
+        if(nextWords.empty()) continue;
+        densePrimes(C, nonzero, depth + 1, mask | (1ULL << i), on, masks);
+        for(size_t j = 0; j < nextWords.size(); ++j) // The bitmaps are kept zero outside their nonzero words
+            next[nextWords[j]] = 0;
+    }
+}
+void CoverSearch::init(vector<vector<int>>& G, int numberOfMinterms){
+    nL = G.size();
+    nR = numberOfMinterms;
+    W = (nR + 63) / 64;
+    // PIs that cover nearby minterms are taken one after another, so the search doesn't depend on the order of the PIs
+    vector<int> lowest(nL, nR);
+    for(int i = 0; i < nL; ++i)
+        for(int j = 0; j < G[i].size(); ++j)
+            lowest[i] = min(lowest[i], G[i][j]);
+    order.resize(nL);
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b){
+        return lowest[a] < lowest[b];
+    });
+    rows.assign((size_t)nL * W, 0);
+    for(int i = 0; i < nL; ++i)
+        for(int j = 0; j < G[order[i]].size(); ++j)
+            rows[(size_t)i * W + (G[order[i]][j] >> 6)] |= 1ULL << (G[order[i]][j] & 63);
+    covered.assign((size_t)(nL + 1) * W, 0);
+    suffix.assign((size_t)(nL + 1) * W, 0);
+    for(int i = nL - 1; i >= 0; --i)
+        for(int w = 0; w < W; ++w)
+            suffix[(size_t)i * W + w] = suffix[(size_t)(i + 1) * W + w] | rows[(size_t)i * W + w];
+    full.assign(W, ~0ULL);
+    if(nR & 63)
+        full[W - 1] = (1ULL << (nR & 63)) - 1;
+    nowCase.assign(nL + 1, 0);
+    weight.resize(nL + 2);
+    for(int d = 0; d <= nL + 1; ++d)
+        weight[d] = ldexp(1.0, -d);
+}
+void CoverSearch::search(int idx, int cost, int coveredCnt){
+    // Skipping a PI changes nothing, so the chain of skips is a loop that takes the PIs from the last one,
+    // which is the order of the recursion that skips first. Taking a PI costs 1, so nothing under a node
+    // can beat minCost once cost + 1 reaches it.
+    if(stats) ++stats->searchNodes;
+    if(limit && limit->check())
         return;
-    bruteForce(G, selected, nowCase, minCase, selCnt, idx + 1, cost, minCost);
-    int cnt = 0;
-    for(int i = 0; i < G[idx].size(); ++i){
-        int u = G[idx][i];
-        if(!selected[u]) ++cnt;
-        ++selected[u];
-    }
-    nowCase.push_back(idx);
-    if(cnt){
-        if(selCnt + cnt == selected.size()){
-            if(minCost == -1 || minCost > cost + 1){
-                minCost = cost + 1;
-                minCase.clear();
-                for(int i = 0; i < nowCase.size(); ++i)
-                    minCase.push_back(nowCase[i]);
+    if(minCost != -1 && minCost <= cost + 1){
+        if(stats) ++stats->prunes;
+        if(limit) limit->explored += weight[idx];
+        return;
+    }
+    const ull* now = &covered[(size_t)cost * W];
+    const ull* rest = &suffix[(size_t)idx * W];
+    for(int w = 0; w < W; ++w)
+        if((now[w] | rest[w]) != full[w]){ // The PIs that are left can't complete the cover
+            if(stats) ++stats->prunes;
+            if(limit) limit->explored += weight[idx];
+            return;
+        }
+    if(limit) limit->explored += weight[nL]; // End of the chain
+    ull* next = &covered[(size_t)(cost + 1) * W];
+    for(int i = nL - 1; i >= idx; --i){
+        if(stats) ++stats->searchNodes;
+        if(limit && limit->check())
+            return;
+        if(minCost != -1 && minCost <= cost + 1){
+            if(stats) ++stats->prunes;
+            if(limit) limit->explored += weight[idx] - weight[i + 1]; // Branches that take idx ... i
+            return;
+        }
+        const ull* row = &rows[(size_t)i * W];
+        int cnt = 0;
+        for(int w = 0; w < W; ++w){
+            next[w] = now[w] | row[w];
+            cnt += __builtin_popcountll(row[w] & ~now[w]);
+        }
+        if(limit && (!cnt || coveredCnt + cnt == nR))
+            limit->explored += weight[i + 1];
+        if(!cnt)
+            continue;
+        nowCase[cost] = order[i];
+        if(coveredCnt + cnt == nR){
+            minCost = cost + 1;
+            minCase->assign(nowCase.begin(), nowCase.begin() + cost + 1);
+        }else
+            search(i + 1, cost + 1, coveredCnt + cnt);
+    }
+}
+void Tabular::bruteForce(vector<vector<int>>& G, int numberOfMinterms, vector<int>& minCase, int& minCost, SolveStats* stats, SearchLimit* limit){
+    // Every node works on preallocated words, nothing is allocated during the search
+    CoverSearch cs;
+    cs.init(G, numberOfMinterms);
+    cs.minCase = &minCase;
+    cs.minCost = minCost;
+    cs.stats = stats;
+    cs.limit = limit;
+    cs.search(0, 0, 0);
+    minCost = cs.minCost;
+}
+CoverStream::CoverStream(){
+    target = -1;
+}
+CoverStream::CoverStream(vector<vector<int>>& GL, int numberOfMinterms, vector<int>& rev, vector<int>& fixed, int minCost, size_t limit){
+    nL = GL.size();
+    W = (numberOfMinterms + 63) / 64;
+    target = minCost;
+    this->rev = rev;
+    this->fixed = fixed;
+    this->limit = limit;
+    produced = 0;
+    rows.assign((size_t)nL * W, 0);
+    for(int i = 0; i < nL; ++i)
+        for(int j = 0; j < GL[i].size(); ++j)
+            rows[(size_t)i * W + GL[i][j] / 64] |= 1ULL << (GL[i][j] % 64);
+    suffix.assign((size_t)(nL + 1) * W, 0);
+    for(int i = nL - 1; i >= 0; --i)
+        for(int w = 0; w < W; ++w)
+            suffix[(size_t)i * W + w] = suffix[(size_t)(i + 1) * W + w] | rows[(size_t)i * W + w];
+    full.assign(W, ~0ULL);
+    if(numberOfMinterms % 64)
+        full[W - 1] = (1ULL << (numberOfMinterms % 64)) - 1;
+    covered.assign((size_t)(max(0, target) + 1) * W, 0);
+    choice.assign(max(0, target) + 1, -1);
+    depth = 0;
+}
+bool CoverStream::next(vector<int>& cover){
+    // Rows are taken in increasing order, so every cover is found once
+    if(target < 0 || produced >= limit)
+        return false;
+    cover = fixed;
+    if(target == 0){ // The EPIs cover everything
+        target = -1;
+        ++produced;
+        return true;
+    }
+    while(depth >= 0){
+        int i = ++choice[depth];
+        const ull* now = &covered[(size_t)depth * W];
+        if(i > nL - (target - depth)){ // Not enough rows left
+            --depth;
+            continue;
+        }
+        bool reachable = true;
+        for(int w = 0; w < W && reachable; ++w)
+            reachable = (now[w] | suffix[(size_t)i * W + w]) == full[w];
+        if(!reachable){ // The remaining rows can't cover the rest, and later i only have less of them
+            --depth;
+            continue;
+        }
+        ull* nxt = &covered[(size_t)(depth + 1) * W];
+        const ull* row = &rows[(size_t)i * W];
+        bool added = false, complete = true;
+        for(int w = 0; w < W; ++w){
+            nxt[w] = now[w] | row[w];
+            added |= (row[w] & ~now[w]) != 0;
+            complete &= nxt[w] == full[w];
+        }
+        if(!added) // A redundant row can't be in a minimum cover
+            continue;
+        if(depth + 1 == target){
+            if(!complete)
+                continue;
+            for(int d = 0; d <= depth; ++d)
+                cover.push_back(rev[choice[d]]);
+            sort(cover.begin(), cover.end());
+            ++produced;
+            return true;
+        }
+        ++depth;
+        choice[depth] = i;
+    }
+    target = -1;
+    return false;
+}
+CoverStream::iterator CoverStream::begin(){
+    return iterator(this);
+}
+CoverStream::iterator CoverStream::end(){
+    return iterator(NULL);
+}
+CoverStream::iterator::iterator(CoverStream* stream){
+    this->stream = stream;
+    if(stream && !stream->next(cover))
+        this->stream = NULL;
+}
+const vector<int>& CoverStream::iterator::operator*() const{
+    return cover;
+}
+const vector<int>* CoverStream::iterator::operator->() const{
+    return &cover;
+}
+CoverStream::iterator& CoverStream::iterator::operator++(){
+    if(stream && !stream->next(cover))
+        stream = NULL;
+    return *this;
+}
+bool CoverStream::iterator::operator==(const iterator& another) const{
+    return stream == another.stream;
+}
+bool CoverStream::iterator::operator!=(const iterator& another) const{
+    return stream != another.stream;
+}
+size_t MemoCover::tableSize(size_t numberOfMinterms){
+    // There are at most 2^minterms states, the table is kept at most half full for them
+    return numberOfMinterms >= 19 ? MEMO_TABLE_SIZE : max((size_t)16, (size_t)2 << numberOfMinterms);
+}
+void MemoCover::init(vector<vector<int>>& GL, vector<vector<int>>& GR, size_t tableSize){
+    rows.assign(GL.size(), 0);
+    for(int p = 0; p < GL.size(); ++p)
+        for(int j = 0; j < GL[p].size(); ++j)
+            rows[p] |= 1ULL << GL[p][j];
+    this->GR = &GR;
+    table.assign(tableSize, Entry{0, 0, -1});
+    used = 0;
+}
+int MemoCover::solve(ull mask, int& choice){
+    // Minimum number of PIs that cover mask, choice is the PI taken for its lowest minterm
+    choice = -1;
+    if(!mask)
+        return 0;
+    size_t slot = (mask * 0x9e3779b97f4a7c15ULL) >> 32 & (table.size() - 1);
+    for(; table[slot].mask; slot = (slot + 1) & (table.size() - 1))
+        if(table[slot].mask == mask){
+            if(stats) ++stats->prunes;
+            choice = table[slot].choice;
+            return table[slot].cost;
+        }
+    if(stats) ++stats->searchNodes;
+    if(limit && limit->check())
+        return 0;
+    vector<int>& candidates = (*GR)[__builtin_ctzll(mask)];
+    int best = INT_MAX;
+    for(int i = 0; i < candidates.size(); ++i){
+        int p = candidates[i], sub;
+        int cost = 1 + solve(mask & ~rows[p], sub);
+        if(limit && limit->expired)
+            return 0;
+        if(cost < best){
+            best = cost;
+            choice = p;
+        }
+    }
+    if(used * 4 < table.size() * 3){ // Probing stays short while the table is at most 3/4 full
+        table[slot] = Entry{mask, best, choice};
+        ++used;
+    }
+    return best;
+}
+bool Tabular::memoFits(vector<vector<int>>& GL, int numberOfMinterms, int cost){
+    // The memoized search branches on the PIs of the lowest uncovered minterm, edges / minterms of them
+    // on average, about as deep as a cover of the given cost. Its states only fit in the table when that is small
+    if(numberOfMinterms > MAX_MEMO_MINTERMS || numberOfMinterms == 0)
+        return numberOfMinterms == 0;
+    long long edges = 0;
+    for(int p = 0; p < GL.size(); ++p)
+        edges += GL[p].size();
+    return cost * log2(max(1.0, (double)edges / numberOfMinterms)) <= MEMO_LOG_STATES;
+}
+void Tabular::memoizedCover(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& minCase, SolveStats* stats, SearchLimit* limit){
+    // At most 64 uncovered minterms, bit u of a mask is minterm u of GR
+    MemoCover memo;
+    memo.init(GL, GR, MemoCover::tableSize(GR.size()));
+    memo.stats = stats;
+    memo.limit = limit;
+    ull mask = GR.size() >= 64 ? ~0ULL : (1ULL << GR.size()) - 1;
+    while(mask){
+        int choice;
+        memo.solve(mask, choice);
+        if(limit && limit->expired)
+            return;
+        minCase.push_back(choice);
+        mask &= ~memo.rows[choice];
+    }
+}
+int Tabular::minimumCost(vector<vector<int>>& GL, vector<vector<int>>& GR, SearchLimit* limit){
+    // From the memoized search when its states fit in the table, otherwise from the bitset search
+    // starting at the greedy cover. Not minimum if the limit expires
+    vector<int> knownCase;
+    greedy(GL, GR, knownCase);
+    int cost = knownCase.size();
+    if(memoFits(GL, GR.size(), cost)){
+        vector<int> memoCase;
+        memoizedCover(GL, GR, memoCase, NULL, limit);
+        if(!limit || !limit->expired)
+            cost = memoCase.size();
+    }else
+        bruteForce(GL, GR.size(), knownCase, cost, NULL, limit);
+    return cost;
+}
+void Tabular::petrick(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<vector<int>>& covers, SolveStats* stats, SearchLimit* limit, int minCost){
+    // Product of sums (sum of the PIs covering each minterm) multiplied out into a sum of products.
+    // A product is a bitset of PIs, products[k * W, (k + 1) * W).
+    int nL = GL.size(), nR = GR.size(), W = max(1, (nL + 63) / 64);
+    // Products bigger than the minimum cost can't be minimum covers, it is found here unless the caller knows it
+    int bound = minCost >= 0 ? minCost : minimumCost(GL, GR, limit);
+    if(limit && limit->expired)
+        return;
+    // Minterms with few alternatives first, so that the products grow slowly
+    vector<int> order(nR);
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b){
+        return GR[a].size() < GR[b].size();
+    });
+
+    vector<ull> sums((size_t)nR * W, 0), used(W);
+    for(int k = 0; k < nR; ++k)
+        for(int q: GR[order[k]])
+            sums[(size_t)k * W + q / 64] |= 1ULL << (q % 64);
+    // Sums from k on that prod doesn't cover and that share no PI with each other need a PI each
+    auto needed = [&](const ull* prod, int k){
+        fill(used.begin(), used.end(), 0);
+        int count = 0;
+        for(; k < nR; ++k){
+            const ull* a = &sums[(size_t)k * W];
+            bool hit = false;
+            for(int w = 0; w < W && !hit; ++w)
+                hit = (prod[w] | used[w]) & a[w];
+            if(hit) continue;
+            ++count;
+            for(int w = 0; w < W; ++w)
+                used[w] |= a[w];
+        }
+        return count;
+    };
+
+    vector<ull> products(W, 0), next;
+    vector<int> sizes(1, 0), nextSizes, idx;
+    long long peak = 0;
+    for(int k = 0; k < nR; ++k){
+        vector<int>& sum = GR[order[k]];
+        const ull* alt = &sums[(size_t)k * W];
+        next.clear(); nextSizes.clear();
+        for(int p = 0; p < sizes.size(); ++p){
+            if(limit && limit->check())
+                return;
+            const ull* prod = &products[(size_t)p * W];
+            if(sizes[p] + needed(prod, k) > bound){
+                if(stats) ++stats->prunes;
+                continue;
             }
-        }else{
-            bruteForce(G, selected, nowCase, minCase, selCnt + cnt, idx + 1, cost + 1, minCost);
+            bool covered = false;
+            for(int w = 0; w < W && !covered; ++w)
+                covered = prod[w] & alt[w];
+            if(covered){ // (P)(P + Q) = P
+                next.insert(next.end(), prod, prod + W);
+                nextSizes.push_back(sizes[p]);
+            }else if(sizes[p] + 1 <= bound){
+                for(int j = 0; j < sum.size(); ++j){
+                    next.insert(next.end(), prod, prod + W);
+                    next[next.size() - W + sum[j] / 64] |= 1ULL << (sum[j] % 64);
+                    nextSizes.push_back(sizes[p] + 1);
+                }
+            }else if(stats)
+                ++stats->prunes;
+        }
+
+        // Duplicates are removed. Absorption (P + PQ = P) isn't needed with the minimum cost as the bound:
+        // the products left at the end are covers of that cost, so none of them is a subset of another
+        idx.resize(nextSizes.size());
+        iota(idx.begin(), idx.end(), 0);
+        sort(idx.begin(), idx.end(), [&](int a, int b){
+            if(nextSizes[a] != nextSizes[b])
+                return nextSizes[a] < nextSizes[b];
+            return lexicographical_compare(next.begin() + (size_t)a * W, next.begin() + (size_t)(a + 1) * W,
+                                           next.begin() + (size_t)b * W, next.begin() + (size_t)(b + 1) * W);
+        });
+        products.clear(); sizes.clear();
+        for(int i = 0; i < idx.size(); ++i){
+            const ull* q = &next[(size_t)idx[i] * W];
+            if(!sizes.empty() && sizes.back() == nextSizes[idx[i]] && equal(q, q + W, products.end() - W)){
+                if(stats) ++stats->prunes;
+                continue;
+            }
+            products.insert(products.end(), q, q + W);
+            sizes.push_back(nextSizes[idx[i]]);
         }
+        if(stats) stats->searchNodes += sizes.size();
+        if(limit) limit->explored = (double)(k + 1) / nR;
+        peak = max(peak, (long long)((next.size() + products.size()) * sizeof(ull) + (nextSizes.size() + idx.size() + sizes.size()) * sizeof(int)));
     }
-    for(int i = 0; i < G[idx].size(); ++i){
-        int u = G[idx][i];
-        --selected[u];
+    if(stats) stats->searchBytes = peak;
+
+    // Products are sorted by size, the first ones are the minimum covers
+    for(int p = 0; p < sizes.size() && sizes[p] == sizes[0]; ++p){
+        covers.push_back(vector<int>());
+        for(int w = 0; w < W; ++w)
+            for(ull t = products[(size_t)p * W + w]; t; t &= t - 1)
+                covers.back().push_back(w * 64 + __builtin_ctzll(t));
     }
-    nowCase.pop_back();
 }
-void Tabular::greedy(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& minCase){
+void Tabular::greedy(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& minCase, SolveControl* control){
     int nL = GL.size(), nR = GR.size();
     MaxSegment<segNode> seg(nL);
     for(int v = 0; v < nL; ++v)
@@ -332,6 +1507,11 @@ void Tabular::greedy(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<in
 
     int count = 0;
     while(count < GR.size()){
+        if(control){
+            if(control->cancelled)
+                throw SolveCancelled();
+            control->fraction = (double)count / GR.size();
+        }
         segNode maxnode = seg.query(0, 0, nL - 1, 0, nL - 1);
         minCase.push_back(maxnode.idx);
         for(auto itr = GLSet[maxnode.idx].begin(); itr != GLSet[maxnode.idx].end(); ++itr){
@@ -348,11 +1528,15 @@ void Tabular::greedy(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<in
     }
 }
 void Tabular::getEPI(){
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    progress(PHASE_EPI, 0);
     // Coordinate compression
+    vector<ull> ons;
+    collectMinterms(ons);
     set<ull> positions;
     map<ull, int> comp;
-    for(int i = 0; i < minterms.size(); ++i)
-        positions.insert(minterms[i]);
+    for(int i = 0; i < ons.size(); ++i)
+        positions.insert(ons[i]);
     int n = 0;
     for(auto itr = positions.begin(); itr != positions.end(); ++itr)
         comp[*itr] = n++;
@@ -371,8 +1555,8 @@ void Tabular::getEPI(){
     }
 
     // Eliminating EPI
-    for(int i = 0; i < minterms.size(); ++i){
-        int compPos = comp[minterms[i]];
+    for(int i = 0; i < ons.size(); ++i){
+        int compPos = comp[ons[i]];
         if(cnt[compPos] == 1){
             if(PIs[last[compPos]].getEPI()) // Already EPI
                 continue;
@@ -380,13 +1564,18 @@ void Tabular::getEPI(){
             ++totNumberOfEPI;
         }
     }
+    stats.numberOfEPIs = totNumberOfEPI;
+    stats.epiTime = elapsed(begin);
 }
 void Tabular::buildGraph(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& rev){
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
     // Coordinate compression
+    vector<ull> ons;
+    collectMinterms(ons);
     set<ull> positions;
     map<ull, int> comp;
-    for(int i = 0; i < minterms.size(); ++i)
-        positions.insert(minterms[i]);
+    for(int i = 0; i < ons.size(); ++i)
+        positions.insert(ons[i]);
     
     // Eliminating coordinates that are satisfied by Coordinate compression
     set<ull> sat;
@@ -407,6 +1596,12 @@ void Tabular::buildGraph(vector<vector<int>>& GL, vector<vector<int>>& GR, vecto
     // Building Bipartite Graph to solve Set Cover problem
     int nA = PIs.size() - totNumberOfEPI;
     int nB = n;
+    long long edges = 0;
+    for(int i = 0; i < PIs.size(); ++i)
+        if(!PIs[i].getEPI())
+            edges += PIs[i].getNumberOfTerms();
+    useMemory(stats.chartBytes, stats.peakChartBytes,
+              ons.size() * sizeof(ull) + (positions.size() + comp.size()) * 48 + (long long)(nA + nB) * sizeof(vector<int>) + edges * 2 * sizeof(int));
 
     GL.resize(nA); GR.resize(nB);
     for(int i = 0, v = 0; i < PIs.size(); ++i){
@@ -422,52 +1617,690 @@ void Tabular::buildGraph(vector<vector<int>>& GL, vector<vector<int>>& GR, vecto
         }
         ++v;
     }
+    stats.graphTime = elapsed(begin);
+}
+void Tabular::reduceGraph(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& rev, vector<int>& forced, bool keepCovers){
+    // Repeats until nothing changes, on bitsets of both directions of the chart:
+    // a minterm covered by one PI makes it a secondary EPI, a minterm whose PIs are a superset of another
+    // minterm's is covered with it, and a PI whose minterms are a subset of another PI's is never needed.
+    // Rows with the same minterms keep the lower one, so at least one minimum cover is left.
+    // With keepCovers the rows are not compared, so every minimum cover of the chart is left.
+    if(!reduction || GR.empty())
+        return;
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    int nL = GL.size(), nR = GR.size(), WR = (nR + 63) / 64, WL = (nL + 63) / 64;
+    useMemory(stats.chartBytes, stats.peakChartBytes, stats.chartBytes + ((long long)nL * WR + (long long)nR * WL) * sizeof(ull) + nL + nR);
+    vector<ull> rowBits((size_t)nL * WR, 0), colBits((size_t)nR * WL, 0);
+    for(int p = 0; p < nL; ++p)
+        for(int j = 0; j < GL[p].size(); ++j){
+            int u = GL[p][j];
+            rowBits[(size_t)p * WR + u / 64] |= 1ULL << (u % 64);
+            colBits[(size_t)u * WL + p / 64] |= 1ULL << (p % 64);
+        }
+    vector<bool> aliveRow(nL, true), aliveCol(nR, true);
+    auto first = [](const ull* bits, int W){
+        for(int w = 0; w < W; ++w)
+            if(bits[w]) return w * 64 + __builtin_ctzll(bits[w]);
+        return -1;
+    };
+    auto subset = [](const ull* a, const ull* b, int W, bool& same){
+        same = true;
+        for(int w = 0; w < W; ++w){
+            if(a[w] & ~b[w]) return false;
+            same &= a[w] == b[w];
+        }
+        return true;
+    };
+    auto removeRow = [&](int p){
+        aliveRow[p] = false;
+        for(int w = 0; w < WR; ++w){
+            for(ull t = rowBits[(size_t)p * WR + w]; t; t &= t - 1)
+                colBits[(size_t)(w * 64 + __builtin_ctzll(t)) * WL + p / 64] &= ~(1ULL << (p % 64));
+            rowBits[(size_t)p * WR + w] = 0;
+        }
+    };
+    auto removeCol = [&](int u){
+        aliveCol[u] = false;
+        for(int w = 0; w < WL; ++w){
+            for(ull t = colBits[(size_t)u * WL + w]; t; t &= t - 1)
+                rowBits[(size_t)(w * 64 + __builtin_ctzll(t)) * WR + u / 64] &= ~(1ULL << (u % 64));
+            colBits[(size_t)u * WL + w] = 0;
+        }
+    };
+
+    for(bool changed = true; changed; ){
+        changed = false;
+        progress(PHASE_COVER, 0);
+        // Secondary essentials
+        for(int u = 0; u < nR; ++u){
+            if(!aliveCol[u]) continue;
+            int count = 0;
+            for(int w = 0; w < WL; ++w)
+                count += __builtin_popcountll(colBits[(size_t)u * WL + w]);
+            if(count != 1) continue;
+            int p = first(&colBits[(size_t)u * WL], WL);
+            forced.push_back(rev[p]);
+            ++stats.secondaryEPIs;
+            for(int v; (v = first(&rowBits[(size_t)p * WR], WR)) != -1; )
+                removeCol(v);
+            removeRow(p);
+            changed = true;
+        }
+        // Column dominance: only the minterms sharing a PI with u can contain its PIs
+        for(int u = 0; u < nR; ++u){
+            if(!aliveCol[u]) continue;
+            const ull* cu = &colBits[(size_t)u * WL];
+            int p = first(cu, WL);
+            if(p == -1) continue;
+            for(int w = 0; w < WR; ++w)
+                for(ull t = rowBits[(size_t)p * WR + w]; t; t &= t - 1){
+                    int v = w * 64 + __builtin_ctzll(t);
+                    bool same;
+                    if(v == u || !subset(cu, &colBits[(size_t)v * WL], WL, same) || (same && v < u))
+                        continue;
+                    removeCol(v);
+                    ++stats.dominatingMinterms;
+                    changed = true;
+                }
+        }
+        // Row dominance: only the PIs covering the first minterm of p can contain its minterms
+        for(int p = 0; p < nL && !keepCovers; ++p){
+            if(!aliveRow[p]) continue;
+            const ull* rp = &rowBits[(size_t)p * WR];
+            int u = first(rp, WR);
+            bool dominated = u == -1;
+            for(int w = 0; w < WL && !dominated; ++w)
+                for(ull t = u == -1 ? 0 : colBits[(size_t)u * WL + w]; t && !dominated; t &= t - 1){
+                    int q = w * 64 + __builtin_ctzll(t);
+                    bool same;
+                    dominated = q != p && subset(rp, &rowBits[(size_t)q * WR], WR, same) && (!same || q < p);
+                }
+            if(dominated){
+                removeRow(p);
+                ++stats.dominatedPIs;
+                changed = true;
+            }
+        }
+    }
+
+    // Compressing the rest of the chart again
+    vector<int> rowIdx(nL, -1), colIdx(nR, -1), nRev;
+    int nA = 0, nB = 0;
+    for(int p = 0; p < nL; ++p)
+        if(aliveRow[p]){
+            rowIdx[p] = nA++;
+            nRev.push_back(rev[p]);
+        }
+    for(int u = 0; u < nR; ++u)
+        if(aliveCol[u])
+            colIdx[u] = nB++;
+    vector<vector<int>> nGL(nA), nGR(nB);
+    for(int p = 0; p < nL; ++p){
+        if(!aliveRow[p]) continue;
+        for(int w = 0; w < WR; ++w)
+            for(ull t = rowBits[(size_t)p * WR + w]; t; t &= t - 1){
+                int u = w * 64 + __builtin_ctzll(t);
+                nGL[rowIdx[p]].push_back(colIdx[u]);
+                nGR[colIdx[u]].push_back(rowIdx[p]);
+            }
+    }
+    GL.swap(nGL);
+    GR.swap(nGR);
+    rev.swap(nRev);
+    stats.graphTime += elapsed(begin);
 }
 vector<int> Tabular::approximationSolver(){
     vector<vector<int>> GL, GR;
     vector<int> rev, ans;
     buildGraph(GL, GR, rev);
+    reduceGraph(GL, GR, rev, ans); // Secondary EPIs are in the answer already
 
     // Greedy
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    long long edges = 0;
+    for(int i = 0; i < GL.size(); ++i)
+        edges += GL[i].size();
+    useMemory(stats.searchBytes, stats.peakSearchBytes, GL.size() * (4 * sizeof(segNode) + sizeof(set<int>)) + edges * 40);
     vector<int> solCase;
-    greedy(GL, GR, solCase);
+    progress(PHASE_COVER, 0);
+    greedy(GL, GR, solCase, control.get());
+    stats.coverTime = elapsed(begin);
 
     for(int i = 0; i < solCase.size(); ++i)
         ans.push_back(rev[solCase[i]]);
     
     return ans;
 }
+void Tabular::coverExact(vector<vector<int>>& GL, vector<vector<int>>& GR, vector<int>& solCase){
+    stats.searchNodes = stats.prunes = 0;
+    // Recursion is as deep as the number of PIs, so the search state is known up front
+    useMemory(stats.searchBytes, stats.peakSearchBytes, (2 * GL.size() + 1) * ((GR.size() + 63) / 64) * sizeof(ull) + GL.size() * (sizeof(int) + 64));
+    int minCost = -1;
+    progress(PHASE_COVER, 0);
+    SearchLimit limit(-1, control.get());
+    bruteForce(GL, GR.size(), solCase, minCost, &stats, &limit);
+    if(limit.cancelled)
+        throw SolveCancelled();
+}
 vector<int> Tabular::trueSolver(){
     vector<vector<int>> GL, GR;
     vector<int> rev, ans;
     buildGraph(GL, GR, rev);
+    reduceGraph(GL, GR, rev, ans); // Secondary EPIs are in the answer already
 
     // Brute force
-    int minCost = -1;
-    vector<int> nowCase, solCase, selected(GR.size(), 0);
-    bruteForce(GL, selected, nowCase, solCase, 0, 0, 0, minCost);
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    vector<int> solCase;
+    coverExact(GL, GR, solCase);
+    stats.coverTime = elapsed(begin);
     
     for(int i = 0; i < solCase.size(); ++i)
         ans.push_back(rev[solCase[i]]);
     
     return ans;
 }
-string Tabular::ansToString(vector<int> ans){
-    string ansEq = "F = ";
-    for(int i = 0; i < ans.size(); ++i){
-        int j = ans[i];
-        string ex = PIs[j].getBits().toString();
-        for(int k = 0; k < ex.size(); ++k){
-            if(ex[k] == '-') continue;
-            ansEq += 'a' + k;
-            if(ex[k] == '0')
-                ansEq += '\'';
+vector<int> Tabular::memoizedSolver(){
+    vector<vector<int>> GL, GR;
+    vector<int> rev, ans;
+    buildGraph(GL, GR, rev);
+    reduceGraph(GL, GR, rev, ans); // Secondary EPIs are in the answer already
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    vector<int> solCase;
+    if(GR.size() > MAX_MEMO_MINTERMS) // Too many uncovered minterms for one word
+        coverExact(GL, GR, solCase);
+    else{
+        stats.searchNodes = stats.prunes = 0;
+        useMemory(stats.searchBytes, stats.peakSearchBytes, MemoCover::tableSize(GR.size()) * sizeof(MemoCover::Entry) + GL.size() * sizeof(ull));
+        progress(PHASE_COVER, 0);
+        SearchLimit limit(-1, control.get());
+        memoizedCover(GL, GR, solCase, &stats, &limit);
+        if(limit.cancelled)
+            throw SolveCancelled();
+    }
+    stats.coverTime = elapsed(begin);
+
+    for(int i = 0; i < solCase.size(); ++i)
+        ans.push_back(rev[solCase[i]]);
+    return ans;
+}
+vector<vector<int>> Tabular::petrickCovers(bool all){
+    // Minimum covers of the chart as PI indices, EPIs are not included. The chart is reduced first,
+    // without row dominance if all of them are asked for
+    vector<vector<int>> GL, GR, covers;
+    vector<int> rev, forced;
+    buildGraph(GL, GR, rev);
+    reduceGraph(GL, GR, rev, forced, all);
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    stats.searchNodes = stats.prunes = 0;
+    progress(PHASE_COVER, 0);
+    SearchLimit limit(-1, control.get());
+    int minCost = -1;
+    if(all){ // Row dominance keeps the minimum cost, which is found much faster on the smaller chart
+        vector<vector<int>> gl(GL), gr(GR);
+        vector<int> r(rev), f;
+        SolveStats kept = stats;
+        reduceGraph(gl, gr, r, f);
+        stats.secondaryEPIs = kept.secondaryEPIs; // Only the reduction of the chart the covers come from is counted
+        stats.dominatedPIs = kept.dominatedPIs;
+        stats.dominatingMinterms = kept.dominatingMinterms;
+        minCost = f.size() + minimumCost(gl, gr, &limit);
+    }
+    petrick(GL, GR, covers, &stats, &limit, minCost);
+    if(limit.cancelled)
+        throw SolveCancelled();
+    // The products are only known after they are built, the peak is charged here
+    useMemory(stats.searchBytes, stats.peakSearchBytes, stats.searchBytes);
+    stats.coverTime = elapsed(begin);
+
+    for(int i = 0; i < covers.size(); ++i){
+        for(int j = 0; j < covers[i].size(); ++j)
+            covers[i][j] = rev[covers[i][j]];
+        covers[i].insert(covers[i].end(), forced.begin(), forced.end());
+    }
+    return covers;
+}
+vector<int> Tabular::petrickSolver(){
+    vector<vector<int>> covers = petrickCovers(false);
+    return covers.empty() ? vector<int>() : covers[0];
+}
+vector<int> Tabular::anytimeSolver(){
+    // Greedy cover is the first bound, then the exact search improves it until the time limit
+    vector<vector<int>> GL, GR;
+    vector<int> rev, ans;
+    buildGraph(GL, GR, rev);
+    reduceGraph(GL, GR, rev, ans); // Secondary EPIs are in the answer already
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    stats.searchNodes = stats.prunes = 0;
+    long long edges = 0;
+    for(int i = 0; i < GL.size(); ++i)
+        edges += GL[i].size();
+    useMemory(stats.searchBytes, stats.peakSearchBytes, GL.size() * (4 * sizeof(segNode) + sizeof(set<int>)) + edges * 40);
+    vector<int> solCase;
+    progress(PHASE_COVER, 0);
+    greedy(GL, GR, solCase, control.get());
+    useMemory(stats.searchBytes, stats.peakSearchBytes, (2 * GL.size() + 1) * ((GR.size() + 63) / 64) * sizeof(ull) + GL.size() * (sizeof(int) + 64));
+    int minCost = solCase.size();
+    SearchLimit limit(timeLimit, control.get());
+    if(!GR.empty())
+        bruteForce(GL, GR.size(), solCase, minCost, &stats, &limit);
+    if(limit.cancelled)
+        throw SolveCancelled();
+    stats.timedOut = limit.expired;
+    stats.coverTime = elapsed(begin);
+
+    for(int i = 0; i < solCase.size(); ++i)
+        ans.push_back(rev[solCase[i]]);
+    return ans;
+}
+vector<int> Tabular::autoSolver(){
+    // The reduced chart is split into its connected parts, and every part gets the engine its size calls for:
+    // exact search for small parts, memoization for parts of one word of minterms whose states fit in the table,
+    // anytime (greedy if there is no time limit) for the rest. Parts are solved smallest first, and every part
+    // beyond the exact search gets the share of the time left that its minterms are of the minterms left.
+    vector<vector<int>> GL, GR;
+    vector<int> rev, ans;
+    buildGraph(GL, GR, rev);
+    reduceGraph(GL, GR, rev, ans); // Secondary EPIs are in the answer already
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    int nL = GL.size(), nR = GR.size();
+    long long edges = 0;
+    for(int p = 0; p < nL; ++p)
+        edges += GL[p].size();
+    vector<int> comp(nL, -1), stack;
+    int nc = 0;
+    for(int s = 0; s < nL; ++s){
+        if(comp[s] != -1) continue;
+        comp[s] = nc;
+        stack.push_back(s);
+        while(!stack.empty()){
+            int p = stack.back();
+            stack.pop_back();
+            for(int u: GL[p])
+                for(int q: GR[u])
+                    if(comp[q] == -1){
+                        comp[q] = nc;
+                        stack.push_back(q);
+                    }
+        }
+        ++nc;
+    }
+    // Rows and columns keep their order in every part, so the searches run as they would on the whole chart
+    vector<vector<int>> rows(nc), cols(nc);
+    vector<int> localRow(nL), localCol(nR);
+    for(int p = 0; p < nL; ++p){
+        localRow[p] = rows[comp[p]].size();
+        rows[comp[p]].push_back(p);
+    }
+    for(int u = 0; u < nR; ++u){
+        localCol[u] = cols[comp[GR[u][0]]].size();
+        cols[comp[GR[u][0]]].push_back(u);
+    }
+    vector<int> order(nc);
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](int a, int b){
+        return cols[a].size() < cols[b].size();
+    });
+    stats.autoSelected = true;
+    stats.components = nc;
+    stats.density = nL && nR ? (double)edges / nL / nR : 0;
+    stats.searchNodes = stats.prunes = 0;
+
+    auto weakness = [](SolveMode mode){
+        return mode == APPROXIMATION ? 3 : mode == ANYTIME ? 2 : mode == MEMOIZED ? 1 : 0;
+    };
+    SearchLimit unlimited(-1, control.get());
+    int done = 0, pending = 0; // Minterms of the parts that are not solved exactly
+    for(int c = 0; c < nc; ++c)
+        if(cols[c].size() > AUTO_EXACT_MINTERMS)
+            pending += cols[c].size();
+    bool timedOut = false;
+    for(int c: order){
+        vector<vector<int>> gl(rows[c].size()), gr(cols[c].size());
+        for(int i = 0; i < rows[c].size(); ++i)
+            for(int u: GL[rows[c][i]])
+                gl[i].push_back(localCol[u]);
+        for(int j = 0; j < cols[c].size(); ++j)
+            for(int q: GR[cols[c][j]])
+                gr[j].push_back(localRow[q]);
+        int minterms = gr.size();
+        stats.largestComponent = max(stats.largestComponent, minterms);
+        progress(PHASE_COVER, nR ? (double)done / nR : 0);
+
+        vector<int> solCase;
+        SolveMode used;
+        if(minterms <= AUTO_EXACT_MINTERMS){
+            used = TRUE_SOLUTION;
+            useMemory(stats.searchBytes, stats.peakSearchBytes, (2 * gl.size() + 1) * sizeof(ull) + gl.size() * (sizeof(int) + 64));
+            int minCost = -1;
+            bruteForce(gl, minterms, solCase, minCost, &stats, &unlimited);
+            if(unlimited.cancelled)
+                throw SolveCancelled();
+        }else{
+            long long budget = -1;
+            if(timeLimit >= 0)
+                budget = max(0LL, timeLimit - elapsed(begin) / 1000000) * minterms / pending;
+            pending -= minterms;
+            SearchLimit limit(budget, control.get());
+            long long edgesOfPart = 0;
+            for(int i = 0; i < gl.size(); ++i)
+                edgesOfPart += gl[i].size();
+            useMemory(stats.searchBytes, stats.peakSearchBytes, gl.size() * (4 * sizeof(segNode) + sizeof(set<int>)) + edgesOfPart * 40);
+            greedy(gl, gr, solCase, control.get()); // Incumbent of the searches, and the answer if they run out of time
+            if(memoFits(gl, minterms, solCase.size())){
+                used = MEMOIZED;
+                useMemory(stats.searchBytes, stats.peakSearchBytes, MemoCover::tableSize(minterms) * sizeof(MemoCover::Entry) + gl.size() * sizeof(ull));
+                vector<int> memoCase;
+                memoizedCover(gl, gr, memoCase, &stats, &limit);
+                if(limit.expired) // Out of time, the greedy cover is kept
+                    used = APPROXIMATION;
+                else
+                    solCase = memoCase;
+            }else{
+                used = timeLimit > 0 ? ANYTIME : APPROXIMATION;
+                if(used == ANYTIME){
+                    useMemory(stats.searchBytes, stats.peakSearchBytes, (2 * gl.size() + 1) * ((minterms + 63) / 64) * sizeof(ull) + gl.size() * (sizeof(int) + 64));
+                    int minCost = solCase.size();
+                    bruteForce(gl, minterms, solCase, minCost, &stats, &limit);
+                }
+            }
+            if(limit.cancelled)
+                throw SolveCancelled();
+            timedOut |= limit.expired;
+        }
+        if(weakness(used) > weakness(stats.autoMode))
+            stats.autoMode = used;
+        for(int i = 0; i < solCase.size(); ++i)
+            ans.push_back(rev[rows[c][solCase[i]]]);
+        done += minterms;
+    }
+    stats.timedOut = timedOut;
+    stats.coverTime = elapsed(begin);
+    return ans;
+}
+ull Tabular::inputMask(){
+    return numberOfInputs >= 64 ? ~0ULL : (1ULL << numberOfInputs) - 1;
+}
+bool Tabular::tautology(vector<Cube>& cover, ull freeMask){
+    // Checks whether cover is 1 on every point of the space spanned by freeMask
+    if(cover.empty())
+        return false;
+    int freeBits = __builtin_popcountll(freeMask);
+    long double volume = 0, space = powl(2.0L, freeBits);
+    vector<int> fixedCnt(64, 0);
+    for(int i = 0; i < cover.size(); ++i){
+        ull fixed = ~cover[i].ask & freeMask;
+        if(!fixed) // Cube that is all '-'
+            return true;
+        volume += powl(2.0L, freeBits - __builtin_popcountll(fixed));
+        for(ull t = fixed; t; t &= t - 1)
+            ++fixedCnt[__builtin_ctzll(t)];
+    }
+    if(volume < space) // Not enough points to fill the space
+        return false;
+
+    // Shannon expansion on the most frequently fixed variable
+    int v = max_element(fixedCnt.begin(), fixedCnt.end()) - fixedCnt.begin();
+    vector<Cube> low, high;
+    for(int i = 0; i < cover.size(); ++i){
+        if(cover[i].ask >> v & 1){
+            low.push_back(cover[i]);
+            high.push_back(cover[i]);
+        }else if(cover[i].bits >> v & 1)
+            high.push_back(cover[i]);
+        else
+            low.push_back(cover[i]);
+    }
+    ull nFree = freeMask & ~(1ULL << v);
+    return tautology(low, nFree) && tautology(high, nFree);
+}
+bool Tabular::coversCube(const vector<Cube>& cover, const Cube& c){
+    // c is covered iff cofactor of cover with respect to c is a tautology
+    ull full = inputMask();
+    vector<Cube> cofactor;
+    for(int i = 0; i < cover.size(); ++i){
+        if(!cover[i].intersects(c)) continue;
+        if(cover[i].contains(Cube(c.bits, c.ask & full)))
+            return true;
+        cofactor.push_back(Cube(cover[i].bits, cover[i].ask | ~c.ask));
+    }
+    return tautology(cofactor, c.ask & full);
+}
+void Tabular::expand(vector<Cube>& F, const vector<Cube>& care){
+    ull full = inputMask();
+    // Bigger cubes first since they are more likely to swallow the others
+    sort(F.begin(), F.end(), [](const Cube& a, const Cube& b){
+        return __builtin_popcountll(a.ask) > __builtin_popcountll(b.ask);
+    });
+    vector<bool> covered(F.size(), false);
+    for(int i = 0; i < F.size(); ++i){
+        progress(PHASE_COVER, 0);
+        if(covered[i]) continue;
+        Cube& c = F[i];
+
+        // Raising literals that are opposed by many other cubes first
+        vector<pair<int, int>> order;
+        for(int v = 0; v < numberOfInputs; ++v){
+            if(c.ask >> v & 1) continue;
+            int cnt = 0;
+            for(int j = 0; j < F.size(); ++j)
+                if(!covered[j] && !(F[j].ask >> v & 1) && (F[j].bits >> v & 1) != (c.bits >> v & 1))
+                    ++cnt;
+            order.push_back(make_pair(-cnt, v));
+        }
+        sort(order.begin(), order.end());
+        for(int k = 0; k < order.size(); ++k){
+            int v = order[k].second;
+            Cube raised(c.bits, c.ask | (1ULL << v));
+            if(coversCube(care, raised))
+                c = raised;
         }
-        if(i < ans.size() - 1) ansEq += " + ";
+        c.ask &= full;
+        for(int j = i + 1; j < F.size(); ++j)
+            if(!covered[j] && c.contains(F[j]))
+                covered[j] = true;
     }
-    return ansEq;
+    vector<Cube> nF;
+    for(int i = 0; i < F.size(); ++i)
+        if(!covered[i])
+            nF.push_back(F[i]);
+    F.swap(nF);
+}
+void Tabular::irredundant(vector<Cube>& F, const vector<Cube>& dc){
+    // Removing cubes that are covered by the rest of the cover, smallest first
+    sort(F.begin(), F.end(), [](const Cube& a, const Cube& b){
+        return __builtin_popcountll(a.ask) > __builtin_popcountll(b.ask);
+    });
+    for(int i = F.size() - 1; i >= 0; --i){
+        vector<Cube> rest(dc);
+        for(int j = 0; j < F.size(); ++j)
+            if(j != i)
+                rest.push_back(F[j]);
+        if(coversCube(rest, F[i]))
+            F.erase(F.begin() + i);
+    }
+}
+void Tabular::reduce(vector<Cube>& F, const vector<Cube>& dc){
+    // Shrinking each cube towards the part that only it covers
+    for(int i = 0; i < F.size(); ++i){
+        vector<Cube> rest(dc);
+        for(int j = 0; j < F.size(); ++j)
+            if(j != i)
+                rest.push_back(F[j]);
+        Cube& c = F[i];
+        for(int v = 0; v < numberOfInputs; ++v){
+            if(!(c.ask >> v & 1)) continue;
+            ull nAsk = c.ask & ~(1ULL << v);
+            if(coversCube(rest, Cube(c.bits, nAsk)))
+                c = Cube(c.bits | (1ULL << v), nAsk);
+            else if(coversCube(rest, Cube(c.bits | (1ULL << v), nAsk)))
+                c = Cube(c.bits, nAsk);
+        }
+    }
+}
+vector<int> Tabular::heuristicSolver(){
+    // Espresso style loop: EXPAND -> IRREDUNDANT -> REDUCE while the cost decreases
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    progress(PHASE_COVER, 0);
+    preprocess();
+    vector<Cube> F(mintermCubes), dc, care;
+    vector<ull> points(minterms);
+    onTable.getPoints(points);
+    for(int i = 0; i < points.size(); ++i)
+        F.push_back(Cube(points[i], 0));
+    collectDontcareCover(dc);
+    care = F;
+    care.insert(care.end(), dc.begin(), dc.end());
+    // Covers are copied for every containment check and cofactored once per variable
+    useMemory(stats.searchBytes, stats.peakSearchBytes, (long long)care.size() * sizeof(Cube) * (numberOfInputs + 4));
+
+    auto cost = [&](const vector<Cube>& cover){
+        int literals = 0;
+        for(int i = 0; i < cover.size(); ++i)
+            literals += numberOfInputs - __builtin_popcountll(cover[i].ask);
+        return make_pair((int)cover.size(), literals);
+    };
+    expand(F, care);
+    irredundant(F, dc);
+    while(!F.empty()){
+        vector<Cube> nF(F);
+        reduce(nF, dc);
+        expand(nF, care);
+        irredundant(nF, dc);
+        if(cost(nF) >= cost(F))
+            break;
+        F.swap(nF);
+    }
+
+    PIs.clear();
+    totNumberOfEPI = 0;
+    vector<int> ans;
+    for(int i = 0; i < F.size(); ++i){
+        Impcnt imp(numberOfInputs, F[i]);
+        for(int j = 0; j < points.size(); ++j) // Cubes given as input are not expanded here
+            if(F[i].contains(Cube(points[j], 0)))
+                imp.addTerm(points[j]);
+        PIs.push_back(imp);
+        ans.push_back(i);
+    }
+    stats.numberOfPIs = PIs.size();
+    stats.coverTime = elapsed(begin);
+    return ans;
+}
+string Tabular::ansToString(const vector<int>& ans){
+    // Written from the packed cubes of the PIs in the format set by setOutputFormat
+    vector<Cube> cover(ans.size());
+    for(int i = 0; i < ans.size(); ++i)
+        cover[i] = PIs[ans[i]].getCube();
+    CoverFormatter formatter(numberOfInputs);
+    formatter.setInputNames(inputNames);
+    if(!outputName.empty()){
+        formatter.setOutputNames({outputName});
+        formatter.setModelName(outputName);
+    }
+    string eq;
+    formatter.write(cover, vector<ull>(cover.size(), 1), outputFormat, eq);
+    return eq;
 }
 string Tabular::solve(bool approx, bool showProcess){
+    return solve(approx ? APPROXIMATION : TRUE_SOLUTION, showProcess);
+}
+string Tabular::solve(SolveMode mode, bool showProcess){
+    stats = SolveStats();
+    status = SOLVED;
+    try{
+        string eq = ansToString(runCached(mode, showProcess));
+        if(control)
+            control->report(PHASE_DONE, 1);
+        return eq;
+    }catch(MemoryLimitError&){
+        status = MEMORY_LIMIT_EXCEEDED;
+        vector<Impcnt>().swap(PIs);
+        if(showProcess)
+            cout << "# Memory limit exceeded" << endl << stats.toString() << endl;
+        return "";
+    }catch(SolveCancelled&){
+        status = CANCELLED;
+        vector<Impcnt>().swap(PIs);
+        if(showProcess)
+            cout << "# Cancelled" << endl;
+        return "";
+    }
+}
+vector<int> Tabular::runCached(SolveMode mode, bool showProcess){
+    if(cache == NULL)
+        return runSolve(mode, showProcess);
+    vector<ull> ons, dcs(dontcares);
+    vector<Cube> dcCubes(dontcareCubes);
+    collectMinterms(ons);
+    dcTable.getPoints(dcs);
+    NPTransform transform(numberOfInputs);
+    if(canonical){
+        // The representative of the NP class is looked up and solved instead, and its cubes are mapped back
+        transform = NPTransform::canonical(numberOfInputs, ons, dcs, candidateLimit);
+        for(int i = 0; i < ons.size(); ++i) ons[i] = transform.apply(ons[i]);
+        for(int i = 0; i < dcs.size(); ++i) dcs[i] = transform.apply(dcs[i]);
+        for(int i = 0; i < dcCubes.size(); ++i) dcCubes[i] = transform.apply(dcCubes[i]);
+    }
+    ResultCache::Key key = ResultCache::makeKey(numberOfInputs, mode, ons, dcs, dcCubes);
+    vector<Cube> cover;
+    vector<int> ans;
+    if(cache->find(key, cover)){
+        stats.cacheHit = true;
+        stats.numberOfPIs = cover.size();
+        if(showProcess)
+            cout << "# Cover found in the cache" << endl;
+    }else if(transform.isIdentity()){
+        ans = runSolve(mode, showProcess);
+        for(int i = 0; i < ans.size(); ++i)
+            cover.push_back(PIs[ans[i]].getCube());
+        if(!stats.timedOut) // A cover cut by the time limit is not the answer of the function
+            cache->insert(key, cover);
+        return ans;
+    }else{
+        if(showProcess)
+            cout << "# Solving the canonical representative..." << endl;
+        Tabular rep(numberOfInputs);
+        rep.minterms = ons;
+        rep.dontcares = dcs;
+        rep.dontcareCubes = dcCubes;
+        rep.dense = dense;
+        rep.reduction = reduction;
+        rep.memoryLimit = memoryLimit;
+        rep.timeLimit = timeLimit;
+        rep.control = control;
+        vector<int> repAns = rep.runSolve(mode, showProcess);
+        stats = rep.stats;
+        for(int i = 0; i < repAns.size(); ++i)
+            cover.push_back(rep.PIs[repAns[i]].getCube());
+        if(!stats.timedOut)
+            cache->insert(key, cover);
+    }
+    PIs.clear();
+    totNumberOfEPI = 0;
+    for(int i = 0; i < cover.size(); ++i){
+        PIs.push_back(Impcnt(numberOfInputs, transform.invert(cover[i])));
+        ans.push_back(i);
+    }
+    return ans;
+}
+vector<int> Tabular::runSolve(SolveMode mode, bool showProcess){
+    if(mode == HEURISTIC){
+        if(showProcess)
+            cout << "# Getting heuristic cover..." << endl;
+        vector<int> ans = heuristicSolver();
+        if(showProcess){
+            cout << "Number of cubes: " << PIs.size() << endl;
+            for(int i = 0; i < PIs.size(); ++i){
+                cout << PIs[i].getBits().toString() << ": ";
+                PIs[i].printTerms(); cout << endl;
+            }
+        }
+        return ans;
+    }
     if(showProcess)
         cout << "# Getting PI(s)..." << endl;
     getPI();
@@ -492,27 +2325,133 @@ string Tabular::solve(bool approx, bool showProcess){
     if(showProcess)
         cout << "# Getting Solution..." << endl;
     vector<int> ans;
-    if(approx)
+    if(mode == APPROXIMATION)
         ans = approximationSolver();
+    else if(mode == ANYTIME)
+        ans = anytimeSolver();
+    else if(mode == MEMOIZED)
+        ans = memoizedSolver();
+    else if(mode == PETRICK)
+        ans = petrickSolver();
+    else if(mode == AUTO)
+        ans = autoSolver();
     else
         ans = trueSolver();
     for(int i = 0, v = 0; i < PIs.size(); ++i)
         if(PIs[i].getEPI())
             ans.push_back(i);
     sort(ans.begin(), ans.end());
-    string eq = ansToString(ans);
-    return eq;
+    if(showProcess)
+        cout << "# Stats" << endl << stats.toString() << endl;
+    return ans;
+}
+vector<string> Tabular::allMinimumSolutions(){
+    // Every minimum solution by Petrick's method, the cache is not used since it keeps one cover
+    stats = SolveStats();
+    status = SOLVED;
+    vector<string> eqs;
+    try{
+        getPI();
+        getEPI();
+        vector<vector<int>> covers = petrickCovers(true);
+        for(int i = 0; i < covers.size(); ++i){
+            for(int j = 0; j < PIs.size(); ++j)
+                if(PIs[j].getEPI())
+                    covers[i].push_back(j);
+            sort(covers[i].begin(), covers[i].end());
+            eqs.push_back(ansToString(covers[i]));
+        }
+        if(control)
+            control->report(PHASE_DONE, 1);
+    }catch(MemoryLimitError&){
+        status = MEMORY_LIMIT_EXCEEDED;
+        vector<Impcnt>().swap(PIs);
+        eqs.clear();
+    }catch(SolveCancelled&){
+        status = CANCELLED;
+        vector<Impcnt>().swap(PIs);
+        eqs.clear();
+    }
+    return eqs;
+}
+CoverStream Tabular::minimumCovers(size_t limit){
+    // The minimum cost is found by the exact search, the covers of that cost are found when they are asked for
+    stats = SolveStats();
+    status = SOLVED;
+    try{
+        getPI();
+        getEPI();
+        vector<vector<int>> GL, GR;
+        vector<int> rev, fixed, solCase;
+        buildGraph(GL, GR, rev);
+        for(int i = 0; i < PIs.size(); ++i)
+            if(PIs[i].getEPI())
+                fixed.push_back(i);
+        chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+        coverExact(GL, GR, solCase);
+        stats.coverTime = elapsed(begin);
+        if(control)
+            control->report(PHASE_DONE, 1);
+        return CoverStream(GL, GR.size(), rev, fixed, solCase.size(), limit);
+    }catch(MemoryLimitError&){
+        status = MEMORY_LIMIT_EXCEEDED;
+    }catch(SolveCancelled&){
+        status = CANCELLED;
+    }
+    vector<Impcnt>().swap(PIs);
+    return CoverStream();
 }
 int Tabular::solveTest(bool approx){
-    getPI();
-    getEPI();
-    vector<int> ans;
-    if(approx)
-        ans = approximationSolver();
-    else
-        ans = trueSolver();
-    for(int i = 0, v = 0; i < PIs.size(); ++i)
-        if(PIs[i].getEPI())
-            ans.push_back(i);
-    return ans.size();
-}
\ No newline at end of file
+    return solveTest(approx ? APPROXIMATION : TRUE_SOLUTION);
+}
+int Tabular::solveTest(SolveMode mode){
+    stats = SolveStats();
+    status = SOLVED;
+    try{
+        int cost = runCached(mode, false).size();
+        if(control)
+            control->report(PHASE_DONE, 1);
+        return cost;
+    }catch(MemoryLimitError&){
+        status = MEMORY_LIMIT_EXCEEDED;
+        vector<Impcnt>().swap(PIs);
+        return -1;
+    }catch(SolveCancelled&){
+        status = CANCELLED;
+        vector<Impcnt>().swap(PIs);
+        return -1;
+    }
+}
+future<string> Tabular::solveAsync(SolveMode mode, shared_ptr<SolveControl> control, ThreadPool* executor){
+    // The Tabular has to outlive the future. The control only applies to this solve,
+    // the one set by setControl is restored when it returns
+    auto run = [this, mode, control](){
+        shared_ptr<SolveControl> previous = this->control;
+        if(control)
+            this->control = control;
+        string answer;
+        try{
+            answer = solve(mode);
+        }catch(...){
+            this->control = previous;
+            throw;
+        }
+        this->control = previous;
+        return answer;
+    };
+    if(executor == NULL)
+        return async(launch::async, run);
+    shared_ptr<packaged_task<string()>> task = make_shared<packaged_task<string()>>(run);
+    executor->submit([task](){ (*task)(); });
+    return task->get_future();
+}
+int Tabular::getNumberOfEPIs(){
+    return totNumberOfEPI;
+}
+const SolveStats& Tabular::getStats(){
+    return stats;
+}
+SolveStatus Tabular::getStatus(){
+    return status;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+/*
+
+title: ThreadPool.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+using namespace std;
+
+// Fixed number of workers that run submitted tasks in FIFO order
+class ThreadPool{
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex lock;
+    condition_variable ready;
+    bool stopping;
+    void work(int index);
+    static int& currentIndex();
+public:
+    ThreadPool(int numberOfThreads);
+    ~ThreadPool();
+    void submit(function<void()> task);
+    int size();
+    static int workerIndex(); // Index of the worker running the caller, -1 outside of the pool
+};
+
+ThreadPool::ThreadPool(int numberOfThreads){
+    stopping = false;
+    for(int i = 0; i < max(1, numberOfThreads); ++i)
+        workers.push_back(thread(&ThreadPool::work, this, i));
+}
+ThreadPool::~ThreadPool(){
+    // Tasks that are already queued are finished first
+    {
+        unique_lock<mutex> guard(lock);
+        stopping = true;
+    }
+    ready.notify_all();
+    for(auto& t: workers)
+        t.join();
+}
+int& ThreadPool::currentIndex(){
+    static thread_local int index = -1;
+    return index;
+}
+void ThreadPool::work(int index){
+    currentIndex() = index;
+    while(true){
+        function<void()> task;
+        {
+            unique_lock<mutex> guard(lock);
+            ready.wait(guard, [this](){ return stopping || !tasks.empty(); });
+            if(tasks.empty())
+                return;
+            task = move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+void ThreadPool::submit(function<void()> task){
+    {
+        unique_lock<mutex> guard(lock);
+        tasks.push(move(task));
+    }
+    ready.notify_one();
+}
+int ThreadPool::size(){
+    return workers.size();
+}
+int ThreadPool::workerIndex(){
+    return currentIndex();
+}
+#endif
@@ -0,0 +1,86 @@
+/*
+
+title: TruthTable.h
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+#ifndef TRUTH_TABLE_H
+#define TRUTH_TABLE_H
+#include <vector>
+#define MAX_DENSE_INPUTS 20 // getPIDense keeps about n + 3 bitmaps of 2^n bits with their word indices, 6MB at 20 inputs
+#define MAX_DENSE_BYTES (64LL << 20) // Footprint up to which getPIDense is used when there is no memory limit
+using namespace std;
+
+typedef unsigned long long int ull;
+
+// Bitmap over the whole 2^numberOfInputs input space, 64 points per word
+class TruthTable{
+private:
+    vector<ull> words;
+    int numberOfInputs;
+public:
+    TruthTable();
+    TruthTable(int numberOfInputs);
+    void set(ull m);
+    bool get(ull m) const;
+    bool empty() const;
+    ull count() const;
+    void getPoints(vector<ull>& points) const;
+    int getNumberOfInputs() const;
+    vector<ull>& getWords();
+    const vector<ull>& getWords() const;
+    static ull flipWord(const vector<ull>& src, size_t w, int var);
+};
+
+TruthTable::TruthTable(){
+    numberOfInputs = 0;
+}
+TruthTable::TruthTable(int numberOfInputs){
+    this->numberOfInputs = numberOfInputs;
+    words.resize(numberOfInputs > 6 ? 1ULL << (numberOfInputs - 6) : 1, 0);
+}
+void TruthTable::set(ull m){
+    words[m >> 6] |= 1ULL << (m & 63);
+}
+bool TruthTable::get(ull m) const{
+    if((m >> 6) >= words.size())
+        return false;
+    return words[m >> 6] >> (m & 63) & 1;
+}
+bool TruthTable::empty() const{
+    for(int i = 0; i < words.size(); ++i)
+        if(words[i]) return false;
+    return true;
+}
+ull TruthTable::count() const{
+    ull cnt = 0;
+    for(int i = 0; i < words.size(); ++i)
+        cnt += __builtin_popcountll(words[i]);
+    return cnt;
+}
+void TruthTable::getPoints(vector<ull>& points) const{
+    for(size_t i = 0; i < words.size(); ++i)
+        for(ull w = words[i]; w; w &= w - 1)
+            points.push_back((i << 6) | __builtin_ctzll(w));
+}
+int TruthTable::getNumberOfInputs() const{
+    return numberOfInputs;
+}
+vector<ull>& TruthTable::getWords(){
+    return words;
+}
+const vector<ull>& TruthTable::getWords() const{
+    return words;
+}
+ull TruthTable::flipWord(const vector<ull>& src, size_t w, int var){
+    // Word w of the bitmap dst[x] = src[x ^ (1 << var)]
+    static const ull lowHalf[6] = {
+        0x5555555555555555ULL, 0x3333333333333333ULL, 0x0F0F0F0F0F0F0F0FULL,
+        0x00FF00FF00FF00FFULL, 0x0000FFFF0000FFFFULL, 0x00000000FFFFFFFFULL
+    };
+    if(var >= 6)
+        return src[w ^ (1ULL << (var - 6))];
+    int shift = 1 << var;
+    return ((src[w] & lowHalf[var]) << shift) | ((src[w] >> shift) & lowHalf[var]);
+}
+#endif
\ No newline at end of file
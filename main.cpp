@@ -6,40 +6,276 @@ author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
 */
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <climits>
+#include <cerrno>
 #include "headers/TabularMethodSolver.h"
+#include "headers/LocalServer.h"
+#include "headers/PlaReader.h"
 using namespace std;
 
 typedef unsigned long long int ull;
+typedef long long int lli;
 
-int main(){
-    freopen("./testCases.txt", "r", stdin);
-    int tcase; cin >> tcase;
-    while(tcase--){
-        vector<ull> minterms, dontcares;
+struct Case{
+    vector<ull> minterms, dontcares;
+    int output; // Output of the PLA file, -1 for the testCases.txt format
+    string answer;
+    lli latency; // ns
+    bool timedOut;
+};
+
+LocalServer* runningServer = NULL; // Stopped by SIGINT and SIGTERM, so the socket file is removed
+
+void stopServer(int){
+    if(runningServer)
+        runningServer->stop();
+}
+
+void usage(){
+    cerr << "usage: main [file | -] [-e exact|dp|petrick|greedy|heuristic|anytime|auto] [-t ms] [-j threads] [-v 0|1|2]" << endl;
+    cerr << "            [-f equation|pla|blif|verilog] [--connect socket]" << endl;
+    cerr << "       main --serve socket [-t ms] [-j threads]" << endl;
+    cerr << "  file     test cases in the testCases.txt format, '-' reads stdin (default: ./testCases.txt)" << endl;
+    cerr << "           a Berkeley PLA file (starting with '.' or '#') is read too, every output is a case" << endl;
+    cerr << "  -e       engine, exact by default; dp and petrick are exact too; anytime improves the greedy cover until the time limit" << endl;
+    cerr << "           auto picks one of them for every connected part of the chart by its size" << endl;
+    cerr << "  -t       time limit of the anytime engine per case (default: 1000)" << endl;
+    cerr << "  -j       number of worker threads (default: 1)" << endl;
+    cerr << "  -f       format of the solutions, equation by default, the others are written on the lines after \"Case #n:\"" << endl;
+    cerr << "  -v       0: summary only, 1: solutions (default), 2: inputs and process, runs on one thread" << endl;
+    cerr << "  --serve  run as a local server on the unix domain socket" << endl;
+    cerr << "  --connect  solve the cases on the server listening on the socket, solutions are equations, not for PLA files" << endl;
+}
+
+bool parseNumber(const string& text, lli least, lli most, lli& value){
+    // The whole argument must be a number in [least, most]
+    char* end = NULL;
+    errno = 0;
+    lli n = strtoll(text.c_str(), &end, 10);
+    if(text.empty() || *end || errno == ERANGE || n < least || n > most)
+        return false;
+    value = n;
+    return true;
+}
+
+bool readCases(istream& in, vector<Case>& cases){
+    // Counts must not be negative, and terms are pushed one by one so that a wrong count can't reserve memory.
+    // A term is read as a ull, which would wrap a leading '-' around, so it is rejected first.
+    auto readTerm = [&](ull& term){
+        return (in >> ws) && in.peek() != '-' && (in >> term);
+    };
+    int tcase;
+    if(!(in >> tcase) || tcase < 0)
+        return false;
+    cases.clear();
+    for(int c = 0; c < tcase; ++c){
+        Case cs;
         int m, d;
-        cin >> m;
-        cout << "Minterms: ";
+        ull term;
+        if(!(in >> m) || m < 0) return false;
+        cs.output = -1;
         for(int i = 0; i < m; ++i){
-            ull t; cin >> t;
-            minterms.push_back(t);
-            cout << t << ", ";
+            if(!readTerm(term)) return false;
+            cs.minterms.push_back(term);
         }
-        cin >> d;
-        cout << endl << "Dont cares: ";
+        if(!(in >> d) || d < 0) return false;
         for(int i = 0; i < d; ++i){
-            ull t; cin >> t;
-            dontcares.push_back(t);
-            cout << t << ", ";
-        }
-        cout << endl;
-        Tabular tabular(minterms, dontcares);
-        string trueSolution = tabular.solve(false, true);
-        string approxSolution = tabular.solve(true);
-        cout << "True solution: " << trueSolution << endl;
-        cout << "Approximation: " << approxSolution << endl;
-        cout << endl;
-    }
-    
+            if(!readTerm(term)) return false;
+            cs.dontcares.push_back(term);
+        }
+        cases.push_back(move(cs));
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]){
+    string path = "./testCases.txt", engine = "exact", formatName = "equation", servePath, connectPath;
+    int threads = 1, verbosity = 1;
+    lli timeLimit = 1000, number;
+    for(int i = 1; i < argc; ++i){
+        string arg = argv[i];
+        bool hasNext = i + 1 < argc;
+        if((arg == "-t" || arg == "-j" || arg == "-v") && hasNext){
+            if(!parseNumber(argv[++i], arg == "-j" ? 1 : 0, arg == "-t" ? LLONG_MAX : arg == "-j" ? 1024 : 2, number)){
+                cerr << "bad number for " << arg << ": " << argv[i] << endl;
+                usage();
+                return 1;
+            }
+            if(arg == "-t") timeLimit = number;
+            else if(arg == "-j") threads = (int)number;
+            else verbosity = (int)number;
+        }
+        else if(arg == "-e" && hasNext) engine = argv[++i];
+        else if(arg == "-f" && hasNext) formatName = argv[++i];
+        else if(arg == "--serve" && hasNext) servePath = argv[++i];
+        else if(arg == "--connect" && hasNext) connectPath = argv[++i];
+        else if(arg == "-h" || arg == "--help"){
+            usage();
+            return 0;
+        }else if(arg == "-" || arg[0] != '-') path = arg;
+        else{
+            usage();
+            return 1;
+        }
+    }
+    if(!servePath.empty()){
+        LocalServer server(servePath, threads);
+        server.setTimeLimit(timeLimit);
+        runningServer = &server;
+        signal(SIGINT, stopServer);
+        signal(SIGTERM, stopServer);
+        bool served = server.run();
+        runningServer = NULL;
+        if(!served){
+            cerr << "cannot listen on " << servePath << endl;
+            return 1;
+        }
+        return 0;
+    }
+    SolveMode mode;
+    CoverFormat format;
+    if(!parseEngine(engine, mode) || !parseFormat(formatName, format) || (format != FORMAT_EQUATION && !connectPath.empty())){
+        usage();
+        return 1;
+    }
+
+    vector<Case> cases;
+    ifstream file;
+    if(path != "-"){
+        file.open(path);
+        if(!file){
+            cerr << "cannot open " << path << endl;
+            return 1;
+        }
+    }
+    // The input is read at once, so that a PLA file can be told from the testCases.txt format by its first character
+    stringstream input;
+    input << (path == "-" ? cin.rdbuf() : file.rdbuf());
+    size_t first = input.str().find_first_not_of(" \t\r\n");
+    bool isPla = first != string::npos && (input.str()[first] == '.' || input.str()[first] == '#');
+    PlaFile pla;
+    string error;
+    if(isPla){
+        if(!connectPath.empty()){
+            usage();
+            return 1;
+        }
+        if(!readPla(input, pla, error)){
+            cerr << "malformed PLA file: " << error << endl;
+            return 1;
+        }
+        cases.resize(pla.numberOfOutputs);
+        for(int o = 0; o < pla.numberOfOutputs; ++o)
+            cases[o].output = o;
+    }else if(!readCases(input, cases)){
+        cerr << "malformed input" << endl;
+        return 1;
+    }
+
+    // The process is printed while solving, so it can't be shared by threads
+    if(verbosity >= 2 && connectPath.empty())
+        threads = 1;
+    atomic<int> next(0);
+    auto worker = [&](){
+        for(int c; (c = next++) < (int)cases.size(); ){
+            Case& cs = cases[c];
+            if(verbosity >= 2 && cs.output >= 0)
+                cout << "Output " << (cs.output < pla.outputNames.size() ? pla.outputNames[cs.output] : to_string(cs.output)) << ": "
+                    << pla.onCubes[cs.output].size() << " ON cube(s), " << pla.dcCubes[cs.output].size() << " don't care cube(s), "
+                    << pla.offCubes[cs.output].size() << " OFF cube(s)" << endl;
+            else if(verbosity >= 2){
+                cout << "Minterms: ";
+                for(auto t: cs.minterms) cout << t << ", ";
+                cout << endl << "Dont cares: ";
+                for(auto t: cs.dontcares) cout << t << ", ";
+                cout << endl;
+            }
+            chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+            Tabular tabular = cs.output >= 0 ? pla.toTabular(cs.output) : Tabular(cs.minterms, cs.dontcares);
+            tabular.setTimeLimit(timeLimit);
+            tabular.setOutputFormat(format);
+            cs.answer = tabular.solve(mode, verbosity >= 2);
+            cs.latency = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count();
+            cs.timedOut = tabular.getStats().timedOut;
+            if(verbosity >= 2)
+                cout << "Solution: " << cs.answer << endl << endl;
+        }
+    };
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    if(connectPath.empty()){
+        vector<thread> pool;
+        for(int i = 0; i < threads; ++i)
+            pool.push_back(thread(worker));
+        for(auto& t: pool)
+            t.join();
+    }else{
+        // Cases are sent in frames of 64 and the results are matched back by id
+        LocalClient client;
+        if(!client.connect(connectPath)){
+            cerr << "cannot connect to " << connectPath << endl;
+            return 1;
+        }
+        vector<chrono::steady_clock::time_point> sent(cases.size());
+        for(int c = 0; c < cases.size(); c += 64){
+            vector<MinimizeRequest> batch;
+            for(int k = c; k < min((int)cases.size(), c + 64); ++k){
+                // The number of inputs is taken from the highest bit among the terms, as Tabular does without it
+                int inputs = 0;
+                for(auto& terms: {cases[k].minterms, cases[k].dontcares})
+                    for(auto t: terms)
+                        while(inputs < 64 && t >> inputs) ++inputs;
+                batch.push_back({(ull)k, engine, inputs, cases[k].minterms, cases[k].dontcares});
+                sent[k] = chrono::steady_clock::now();
+            }
+            if(!client.send(batch)){
+                cerr << "connection lost" << endl;
+                return 1;
+            }
+        }
+        MinimizeResult result;
+        for(int c = 0; c < cases.size(); ++c){
+            if(!client.receive(result) || result.id >= cases.size()){
+                cerr << "connection lost" << endl;
+                return 1;
+            }
+            Case& cs = cases[result.id];
+            cs.answer = result.ok ? result.answer : "error: " + result.answer;
+            cs.latency = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - sent[result.id]).count();
+            cs.timedOut = false;
+        }
+    }
+    double wall = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count() / 1e9;
+
+    if(verbosity == 1)
+        for(int c = 0; c < cases.size(); ++c)
+            cout << "Case #" << c + 1 << ":" << (format == FORMAT_EQUATION ? " " : "\n") << cases[c].answer << (cases[c].timedOut ? " (time limit)" : "") << endl;
+
+    // Summary goes to stderr so that the solutions can be piped
+    vector<lli> latency;
+    int timedOut = 0;
+    for(auto& cs: cases){
+        latency.push_back(cs.latency);
+        timedOut += cs.timedOut;
+    }
+    sort(latency.begin(), latency.end());
+    auto percentile = [&](double p){
+        return latency.empty() ? 0 : latency[min(latency.size() - 1, (size_t)(p * latency.size()))] / 1000;
+    };
+    cerr << "# " << cases.size() << " cases, engine " << engine << ", " << threads << " thread(s), " << wall << "s, "
+        << (wall > 0 ? cases.size() / wall : 0) << " problems/s" << endl;
+    cerr << "# latency (us): p50 " << percentile(0.5) << ", p90 " << percentile(0.9) << ", p99 " << percentile(0.99)
+        << ", max " << (latency.empty() ? 0 : latency.back() / 1000) << endl;
+    if(mode == ANYTIME || mode == AUTO)
+        cerr << "# " << timedOut << " case(s) stopped at the time limit" << endl;
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,251 @@
+/*
+
+title: Tabular method solver benchmark
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <set>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <cstdlib>
+#include <climits>
+#include "../headers/TabularMethodSolver.h"
+#include "../headers/PlaReader.h"
+using namespace std;
+
+typedef unsigned long long int ull;
+typedef long long int lli;
+
+enum ScenarioKind{ RANDOM, CYCLIC, PLA };
+
+struct Scenario{
+    string name;
+    ScenarioKind kind;
+    int inputs;
+    int minterms; // RANDOM: number of minterms, CYCLIC: number of cyclic blocks
+    int dontcares;
+    bool exact; // false if the exact solver is hopeless for this scenario
+    const PlaFile* pla; // PLA: the file and its output solved by the scenario
+    int output;
+};
+
+struct Sample{
+    string scenario, engine;
+    int seed, rep, cost;
+    lli piTime, epiTime, graphTime, coverTime, totalTime;
+    lli pairsCompared, merges, searchNodes, prunes;
+};
+
+vector<Scenario> scenarios(){
+    return {
+        {"sparse-8",        RANDOM,  8,  20,  4, true, NULL, -1},
+        {"sparse-10",       RANDOM, 10,  40, 10, true, NULL, -1},
+        {"sparse-12",       RANDOM, 12,  60, 10, false, NULL, -1},
+        {"dense-5",         RANDOM,  5,  18,  4, true, NULL, -1},
+        {"dense-6",         RANDOM,  6,  38,  6, false, NULL, -1},
+        {"dense-8",         RANDOM,  8, 150, 25, false, NULL, -1},
+        {"dc-ratio-0",      RANDOM, 10,  60,  0, true, NULL, -1},
+        {"dc-ratio-50",     RANDOM, 10,  60, 30, true, NULL, -1},
+        {"dc-ratio-100",    RANDOM, 10,  60, 60, true, NULL, -1},
+        {"cyclic-4",        CYCLIC,  8,   4,  0, true, NULL, -1},
+        {"cyclic-5",        CYCLIC, 10,   5,  0, true, NULL, -1},
+        {"cyclic-8",        CYCLIC, 10,   8,  0, true, NULL, -1},
+        {"cyclic-16",       CYCLIC, 11,  16,  0, false, NULL, -1},
+    };
+}
+
+vector<Scenario> plaScenarios(const string& path, const PlaFile& pla){
+    // One scenario per output, named file:output
+    string base = path.substr(path.find_last_of('/') + 1);
+    vector<Scenario> list;
+    for(int o = 0; o < pla.numberOfOutputs; ++o){
+        string output = o < pla.outputNames.size() ? pla.outputNames[o] : to_string(o);
+        list.push_back({base + ":" + output, PLA, pla.numberOfInputs, 0, 0, true, &pla, o});
+    }
+    return list;
+}
+
+void generate(const Scenario& sc, int seed, vector<ull>& minterms, vector<ull>& dontcares){
+    mt19937_64 rng(seed);
+    ull space = 1ULL << sc.inputs;
+    if(sc.kind == CYCLIC){
+        // Copies of the cyclic function {0, 1, 2, 5, 6, 7} on the low 3 bits.
+        // Blocks use high parts with even parity so that no two blocks can be combined.
+        const ull core[] = {0, 1, 2, 5, 6, 7};
+        for(ull high = 0, blocks = 0; blocks < sc.minterms && (high << 3) < space; ++high){
+            if(__builtin_popcountll(high) & 1) continue;
+            for(auto c: core)
+                minterms.push_back(high << 3 | c);
+            ++blocks;
+        }
+        return;
+    }
+    set<ull> exi;
+    uniform_int_distribution<ull> dist(0, space - 1);
+    while(minterms.size() < sc.minterms && exi.size() < space){
+        ull n = dist(rng);
+        if(exi.insert(n).second)
+            minterms.push_back(n);
+    }
+    while(dontcares.size() < sc.dontcares && exi.size() < space){
+        ull n = dist(rng);
+        if(exi.insert(n).second)
+            dontcares.push_back(n);
+    }
+}
+
+Sample measure(const Scenario& sc, const string& engine, int seed, int rep, vector<ull>& minterms, vector<ull>& dontcares){
+    Sample s;
+    s.scenario = sc.name; s.engine = engine; s.seed = seed; s.rep = rep;
+    Tabular tabular = sc.kind == PLA ? sc.pla->toTabular(sc.output) : Tabular(sc.inputs, minterms, dontcares);
+    SolveMode mode;
+    parseEngine(engine, mode); // Checked by main
+    s.cost = tabular.solveTest(mode);
+    const SolveStats& stats = tabular.getStats();
+    s.piTime = stats.piTime; s.epiTime = stats.epiTime;
+    s.graphTime = stats.graphTime; s.coverTime = stats.coverTime;
+    s.totalTime = s.piTime + s.epiTime + s.graphTime + s.coverTime;
+    s.pairsCompared = stats.pairsCompared; s.merges = stats.merges;
+    s.searchNodes = stats.searchNodes; s.prunes = stats.prunes;
+    return s;
+}
+
+void usage(){
+    cerr << "usage: benchmark [--format text|csv|json] [--output file] [--scenario name] [--engine exact|dp|petrick|greedy|heuristic|anytime|auto]" << endl;
+    cerr << "                 [--warmup n] [--reps n] [--seeds n] [--pla file] [--list]" << endl;
+}
+
+bool parseCount(const string& text, int least, int& value){
+    // The whole argument must be a number of at least least
+    char* end = NULL;
+    long n = strtol(text.c_str(), &end, 10);
+    if(text.empty() || *end || n < least || n > INT_MAX)
+        return false;
+    value = (int)n;
+    return true;
+}
+
+int main(int argc, char* argv[]){
+    string format = "text", outPath, only, plaPath;
+    int warmup = 1, reps = 3, seeds = 5;
+    bool listOnly = false;
+    vector<string> engines = {"exact", "greedy", "heuristic"};
+    for(int i = 1; i < argc; ++i){
+        string arg = argv[i];
+        string next = i + 1 < argc ? argv[i + 1] : "";
+        if(arg == "--format"){
+            if(next != "text" && next != "csv" && next != "json"){
+                usage();
+                return 1;
+            }
+            format = next, ++i;
+        }
+        else if(arg == "--output") outPath = next, ++i;
+        else if(arg == "--scenario") only = next, ++i;
+        else if(arg == "--warmup" || arg == "--reps" || arg == "--seeds"){
+            if(!parseCount(next, arg == "--warmup" ? 0 : 1, arg == "--warmup" ? warmup : arg == "--reps" ? reps : seeds)){
+                usage();
+                return 1;
+            }
+            ++i;
+        }
+        else if(arg == "--engine"){
+            SolveMode mode;
+            if(!parseEngine(next, mode)){
+                usage();
+                return 1;
+            }
+            engines = {next}, ++i;
+        }
+        else if(arg == "--pla") plaPath = next, ++i;
+        else if(arg == "--list") listOnly = true;
+        else{
+            usage();
+            return 1;
+        }
+    }
+
+    // With a PLA file, its outputs replace the built-in scenarios
+    PlaFile pla;
+    vector<Scenario> list = scenarios();
+    if(!plaPath.empty()){
+        string error;
+        if(!readPla(plaPath, pla, error)){
+            cerr << plaPath << ": " << error << endl;
+            return 1;
+        }
+        list = plaScenarios(plaPath, pla);
+    }
+    if(listOnly){
+        for(auto& sc: list)
+            cout << sc.name << endl;
+        return 0;
+    }
+
+    vector<Sample> samples;
+    for(auto& sc: list){
+        if(!only.empty() && sc.name != only) continue;
+        for(auto& engine: engines){
+            if((engine == "exact" || engine == "dp" || engine == "petrick") && !sc.exact) continue;
+            int scenarioSeeds = sc.kind == RANDOM ? seeds : 1; // Cyclic charts and PLA files don't depend on the seed
+            for(int seed = 0; seed < scenarioSeeds; ++seed){
+                vector<ull> minterms, dontcares;
+                generate(sc, seed, minterms, dontcares);
+                for(int w = 0; w < warmup; ++w)
+                    measure(sc, engine, seed, -1, minterms, dontcares);
+                for(int r = 0; r < reps; ++r)
+                    samples.push_back(measure(sc, engine, seed, r, minterms, dontcares));
+            }
+            cerr << sc.name << " / " << engine << " done" << endl;
+        }
+    }
+
+    ofstream file;
+    if(!outPath.empty())
+        file.open(outPath);
+    ostream& out = outPath.empty() ? cout : file;
+    if(format == "csv"){
+        out << "scenario,engine,seed,rep,cost,pi_ns,epi_ns,graph_ns,cover_ns,total_ns,pairs_compared,merges,search_nodes,prunes" << endl;
+        for(auto& s: samples)
+            out << s.scenario << "," << s.engine << "," << s.seed << "," << s.rep << "," << s.cost << ","
+                << s.piTime << "," << s.epiTime << "," << s.graphTime << "," << s.coverTime << "," << s.totalTime << ","
+                << s.pairsCompared << "," << s.merges << "," << s.searchNodes << "," << s.prunes << endl;
+    }else if(format == "json"){
+        out << "[" << endl;
+        for(int i = 0; i < samples.size(); ++i){
+            Sample& s = samples[i];
+            out << "  {\"scenario\": \"" << s.scenario << "\", \"engine\": \"" << s.engine << "\", \"seed\": " << s.seed
+                << ", \"rep\": " << s.rep << ", \"cost\": " << s.cost << ", \"pi_ns\": " << s.piTime << ", \"epi_ns\": " << s.epiTime
+                << ", \"graph_ns\": " << s.graphTime << ", \"cover_ns\": " << s.coverTime << ", \"total_ns\": " << s.totalTime
+                << ", \"pairs_compared\": " << s.pairsCompared << ", \"merges\": " << s.merges << ", \"search_nodes\": " << s.searchNodes
+                << ", \"prunes\": " << s.prunes << "}" << (i + 1 < samples.size() ? "," : "") << endl;
+        }
+        out << "]" << endl;
+    }else{
+        // Median of every (scenario, engine)
+        for(int i = 0; i < samples.size(); ){
+            int j = i;
+            vector<lli> total, pi, epi, graph, cover;
+            lli cost = 0;
+            for(; j < samples.size() && samples[j].scenario == samples[i].scenario && samples[j].engine == samples[i].engine; ++j){
+                total.push_back(samples[j].totalTime); pi.push_back(samples[j].piTime);
+                epi.push_back(samples[j].epiTime); graph.push_back(samples[j].graphTime); cover.push_back(samples[j].coverTime);
+                cost += samples[j].cost;
+            }
+            auto median = [](vector<lli>& v){
+                sort(v.begin(), v.end());
+                return v[v.size() / 2];
+            };
+            out << samples[i].scenario << " / " << samples[i].engine << ": total " << median(total) << "ns (pi " << median(pi)
+                << ", epi " << median(epi) << ", graph " << median(graph) << ", cover " << median(cover) << "), mean cost " << (double)cost / (j - i) << endl;
+            i = j;
+        }
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,700 @@
+/*
+
+title: Differential fuzzer of the tabular method solver
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <set>
+#include <string>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include "../headers/TabularMethodSolver.h"
+#include "../headers/MultiOutputSolver.h"
+using namespace std;
+
+typedef unsigned long long int ull;
+
+// How the function is given to the solver
+enum InputKind{ MINTERMS, TABLE, CUBES };
+// What is run and checked: one solve, a solve repeated on a ResultCache, a solve of the function and of a permuted
+// and complemented copy on a canonical cache, every minimum solution, the stream of minimum covers, or MultiTabular
+enum CheckKind{ SOLVE, CACHED, CANONICAL, ALL_MINIMUM, STREAM, MULTI };
+
+struct Engine{
+    string name;
+    SolveMode mode;
+    InputKind input;
+    CheckKind check;
+    bool dense; // getPI on the bitmaps
+    bool reduction; // Dominance reduction of the chart
+    bool exact; // The cost has to be the minimum
+};
+
+vector<Engine> engines(){
+    return {
+        {"exact",            TRUE_SOLUTION, MINTERMS, SOLVE,       false, true,  true},
+        {"exact-dense",      TRUE_SOLUTION, MINTERMS, SOLVE,       true,  true,  true},
+        {"exact-unreduced",  TRUE_SOLUTION, MINTERMS, SOLVE,       false, false, true},
+        {"exact-table",      TRUE_SOLUTION, TABLE,    SOLVE,       true,  true,  true},
+        {"exact-table-list", TRUE_SOLUTION, TABLE,    SOLVE,       false, true,  true}, // Truth tables expanded for the list path
+        {"exact-cubes",      TRUE_SOLUTION, CUBES,    SOLVE,       false, true,  true},
+        {"exact-cached",     TRUE_SOLUTION, MINTERMS, CACHED,      false, true,  true},
+        {"exact-canonical",  TRUE_SOLUTION, MINTERMS, CANONICAL,   false, true,  true},
+        {"dp",               MEMOIZED,      MINTERMS, SOLVE,       false, true,  true},
+        {"petrick",          PETRICK,       MINTERMS, SOLVE,       false, true,  true},
+        {"all-minimum",      PETRICK,       MINTERMS, ALL_MINIMUM, false, true,  true},
+        {"minimum-covers",   TRUE_SOLUTION, MINTERMS, STREAM,      false, true,  true},
+        {"anytime",          ANYTIME,       MINTERMS, SOLVE,       false, true,  true}, // The cases are small enough to finish in the time limit
+        {"auto",             AUTO,          MINTERMS, SOLVE,       false, true,  true}, // At most 64 minterms, so every part is solved exactly
+        {"multi-exact",      TRUE_SOLUTION, MINTERMS, MULTI,       false, true,  true},
+        {"greedy",           APPROXIMATION, MINTERMS, SOLVE,       false, true,  false},
+        {"greedy-unreduced", APPROXIMATION, MINTERMS, SOLVE,       false, false, false},
+        {"greedy-table-list",APPROXIMATION, TABLE,    SOLVE,       false, true,  false},
+        {"greedy-cubes",     APPROXIMATION, CUBES,    SOLVE,       false, true,  false},
+        {"multi-greedy",     APPROXIMATION, MINTERMS, MULTI,       false, true,  false},
+        {"heuristic",        HEURISTIC,     MINTERMS, SOLVE,       false, true,  false},
+        {"heuristic-cubes",  HEURISTIC,     CUBES,    SOLVE,       false, true,  false},
+    };
+}
+
+vector<Engine> largeEngines(){
+    // Past 64 minterms, solved with a time limit and cancelled by a watchdog. There is no independent reference,
+    // so exact means that the cost has to be the minimum found by the others unless the solve reports a timeout
+    return {
+        {"exact",            TRUE_SOLUTION, MINTERMS, SOLVE,       false, true,  true},
+        {"exact-dense",      TRUE_SOLUTION, TABLE,    SOLVE,       true,  true,  true},
+        {"exact-unreduced",  TRUE_SOLUTION, MINTERMS, SOLVE,       false, false, true},
+        {"dp",               MEMOIZED,      MINTERMS, SOLVE,       false, true,  true}, // Falls back past 64 minterms
+        {"petrick",          PETRICK,       MINTERMS, SOLVE,       false, true,  true},
+        {"auto",             AUTO,          MINTERMS, SOLVE,       false, true,  true},
+        {"anytime",          ANYTIME,       MINTERMS, SOLVE,       false, true,  true},
+        {"greedy",           APPROXIMATION, MINTERMS, SOLVE,       false, true,  false},
+    };
+}
+
+// Value of every point: 0 = OFF, 1 = ON, 2 = don't care
+typedef vector<int> Function;
+
+// A random function with its reference results and the other forms it is given in
+struct Problem{
+    int n;
+    Function f, g; // g: second output of MULTI, f itself half of the time
+    vector<ull> minterms, dontcares;
+    vector<Cube> onCubes, dcCubes;
+    int reference, referenceG;
+    size_t minimumCovers; // Number of distinct minimum covers
+};
+
+bool parseEquation(const string& eq, int n, vector<Cube>& cover){
+    // "F = ab' + c" -> cubes, variable a is the most significant bit. A term without literals is 1
+    size_t start = eq.find(" = ");
+    if(start == string::npos)
+        return false;
+    ull full = n >= 64 ? ~0ULL : (1ULL << n) - 1;
+    Cube c(0, full);
+    for(size_t i = start + 3; i <= eq.size(); ++i){
+        if(i == eq.size() || eq[i] == '+'){
+            cover.push_back(c);
+            c = Cube(0, full);
+        }else if(eq[i] >= 'a' && eq[i] < 'a' + n){
+            int v = n - 1 - (eq[i] - 'a');
+            bool neg = i + 1 < eq.size() && eq[i + 1] == '\'';
+            c.ask &= ~(1ULL << v);
+            if(!neg)
+                c.bits |= 1ULL << v;
+        }else if(eq[i] != ' ' && eq[i] != '\'')
+            return false;
+    }
+    return true;
+}
+
+string verify(const Function& f, const vector<Cube>& cover){
+    // Every ON point is covered and no OFF point is
+    vector<bool> covered(f.size(), false);
+    for(auto& c: cover)
+        for(ull p = 0; p < f.size(); ++p)
+            if(c.contains(Cube(p, 0))){
+                if(f[p] == 0)
+                    return "covers OFF point " + to_string(p);
+                covered[p] = true;
+            }
+    for(ull p = 0; p < f.size(); ++p)
+        if(f[p] == 1 && !covered[p])
+            return "misses ON point " + to_string(p);
+    return "";
+}
+
+int referenceCost(const Function& f, int n, size_t* minimumCovers=NULL){
+    // Independent of the solver: PIs by checking every cube, then the smallest number of them covering ON.
+    // minimumCovers gets the number of distinct sets of PIs of that size covering ON
+    vector<Cube> implicants;
+    ull full = (1ULL << n) - 1;
+    for(ull ask = 0; ask <= full; ++ask)
+        for(ull bits = 0; bits <= full; ++bits){
+            if(bits & ask) continue;
+            bool inside = true, hasOn = false;
+            for(ull p = 0; p <= full && inside; ++p)
+                if((p & ~ask) == bits){
+                    inside = f[p] != 0;
+                    hasOn |= f[p] == 1;
+                }
+            if(inside && hasOn)
+                implicants.push_back(Cube(bits, ask));
+        }
+    vector<ull> rows; // Points of ON covered by each PI, at most 64 points with n <= 6
+    for(auto& c: implicants){
+        bool prime = true;
+        for(auto& d: implicants)
+            if(!(c == d) && d.contains(c))
+                prime = false;
+        if(!prime) continue;
+        ull row = 0;
+        for(ull p = 0; p <= full; ++p)
+            if(f[p] == 1 && c.contains(Cube(p, 0)))
+                row |= 1ULL << p;
+        rows.push_back(row);
+    }
+    ull on = 0;
+    for(ull p = 0; p <= full; ++p)
+        if(f[p] == 1)
+            on |= 1ULL << p;
+    // Iterative deepening on the lowest uncovered point
+    function<bool(ull, int)> coverable = [&](ull left, int k){
+        if(!left) return true;
+        if(!k) return false;
+        int p = __builtin_ctzll(left);
+        for(auto row: rows)
+            if(row >> p & 1 && coverable(left & ~row, k - 1))
+                return true;
+        return false;
+    };
+    int k = 0;
+    while(!coverable(on, k))
+        ++k;
+    if(minimumCovers){
+        // The same set is reached in every order of its rows, so the sets are collected
+        set<vector<int>> covers;
+        vector<int> chosen;
+        function<void(ull, int)> collect = [&](ull left, int k){
+            if(!left){
+                vector<int> cover(chosen);
+                sort(cover.begin(), cover.end());
+                covers.insert(cover);
+                return;
+            }
+            if(!k) return;
+            int p = __builtin_ctzll(left);
+            for(int i = 0; i < (int)rows.size(); ++i)
+                if(rows[i] >> p & 1){
+                    chosen.push_back(i);
+                    collect(left & ~rows[i], k - 1);
+                    chosen.pop_back();
+                }
+        };
+        collect(on, k);
+        *minimumCovers = covers.size();
+    }
+    return k;
+}
+
+void splitIntoCubes(const Function& f, int n, int value, mt19937_64& rng, vector<Cube>& cubes){
+    // Cubes grown from every point of the value not covered yet, inside the points where f is value
+    // (ON cubes) or not OFF (don't care cubes, so that they overlap ON and the minterm wins)
+    vector<ull> points;
+    for(ull p = 0; p < f.size(); ++p)
+        if(f[p] == value)
+            points.push_back(p);
+    shuffle(points.begin(), points.end(), rng);
+    vector<int> order(n);
+    for(int v = 0; v < n; ++v) order[v] = v;
+    for(auto p: points){
+        bool covered = false;
+        for(auto& c: cubes)
+            covered |= c.contains(Cube(p, 0));
+        if(covered && rng() % 2) continue;
+        Cube c(p, 0);
+        shuffle(order.begin(), order.end(), rng);
+        for(int v: order){
+            Cube bigger(c.bits, c.ask | 1ULL << v);
+            bool inside = true;
+            for(ull t = bigger.ask; inside; t = (t - 1) & bigger.ask){
+                int x = f[bigger.bits | t];
+                inside = value == 1 ? x == 1 : x != 0;
+                if(!t) break;
+            }
+            if(inside && rng() % 3)
+                c = bigger;
+        }
+        cubes.push_back(c);
+    }
+}
+
+Function transform(const Function& f, int n, const vector<int>& perm, ull mask){
+    // Input v goes to perm[v], then the inputs of mask are complemented
+    Function g(f.size());
+    for(ull p = 0; p < f.size(); ++p){
+        ull q = 0;
+        for(int v = 0; v < n; ++v)
+            q |= (p >> v & 1) << perm[v];
+        g[q ^ mask] = f[p];
+    }
+    return g;
+}
+
+string checkCover(const Function& f, const string& eq, int n, int reference, bool exact, vector<Cube>* parsed=NULL){
+    vector<Cube> cover;
+    if(!parseEquation(eq, n, cover))
+        return "malformed equation";
+    string error = verify(f, cover);
+    if(error.empty() && exact && (int)cover.size() != reference)
+        error = "cost " + to_string(cover.size()) + ", minimum " + to_string(reference);
+    if(error.empty() && (int)cover.size() < reference)
+        error = "cost " + to_string(cover.size()) + " below the minimum " + to_string(reference);
+    if(parsed)
+        *parsed = cover;
+    return error;
+}
+
+Tabular build(const Engine& engine, const Problem& pb){
+    int n = pb.n;
+    vector<ull> mins(pb.minterms), dons(pb.dontcares);
+    if(engine.input == TABLE){
+        TruthTable on(n), dc(n);
+        for(auto m: pb.minterms) on.set(m);
+        for(auto d: pb.dontcares) dc.set(d);
+        return Tabular(on, dc);
+    }
+    if(engine.input == CUBES){
+        Tabular tabular(n);
+        for(auto& c: pb.onCubes) tabular.addMintermCube(c.bits, c.ask);
+        for(auto& c: pb.dcCubes) tabular.addDontcareCube(c.bits, c.ask);
+        return tabular;
+    }
+    return Tabular(n, mins, dons);
+}
+
+string run(const Engine& engine, const Problem& pb, mt19937_64& rng, ResultCache& canonicalCache, string& shown){
+    // Runs the engine on the problem, returns the error or "" and sets what is printed with a failure
+    int n = pb.n;
+    Tabular tabular = build(engine, pb);
+    tabular.setDense(engine.dense);
+    tabular.setReduction(engine.reduction);
+
+    if(engine.check == SOLVE){
+        shown = tabular.solve(engine.mode);
+        if(tabular.getStatus() != SOLVED) return "not solved";
+        return checkCover(pb.f, shown, n, pb.reference, engine.exact);
+    }
+    if(engine.check == CACHED){
+        // The second solve of the same function has to come from the cache
+        ResultCache cache(16);
+        tabular.setCache(&cache);
+        shown = tabular.solve(engine.mode);
+        string error = checkCover(pb.f, shown, n, pb.reference, engine.exact);
+        if(!error.empty()) return "first solve: " + error;
+        Tabular again = build(engine, pb);
+        again.setCache(&cache);
+        shown = again.solve(engine.mode);
+        if(!again.getStats().cacheHit) return "second solve missed the cache";
+        return checkCover(pb.f, shown, n, pb.reference, engine.exact);
+    }
+    if(engine.check == CANONICAL){
+        // The cache is shared by every iteration, so NP-equivalent functions met before are mapped back too
+        tabular.setCache(&canonicalCache);
+        tabular.setCanonical(true);
+        shown = tabular.solve(engine.mode);
+        string error = checkCover(pb.f, shown, n, pb.reference, engine.exact);
+        if(!error.empty()) return error;
+        vector<int> perm(n);
+        for(int v = 0; v < n; ++v) perm[v] = v;
+        shuffle(perm.begin(), perm.end(), rng);
+        ull mask = rng() & ((1ULL << n) - 1);
+        Function g = transform(pb.f, n, perm, mask);
+        vector<ull> mins, dons;
+        for(ull p = 0; p < g.size(); ++p){
+            if(g[p] == 1) mins.push_back(p);
+            if(g[p] == 2) dons.push_back(p);
+        }
+        Tabular copy(n, mins, dons);
+        copy.setCache(&canonicalCache);
+        copy.setCanonical(true);
+        shown = copy.solve(engine.mode);
+        error = checkCover(g, shown, n, pb.reference, engine.exact);
+        return error.empty() ? "" : "transformed copy: " + error;
+    }
+    if(engine.check == ALL_MINIMUM || engine.check == STREAM){
+        // Every minimum cover once, as many as the reference finds
+        vector<string> eqs;
+        if(engine.check == ALL_MINIMUM)
+            eqs = tabular.allMinimumSolutions();
+        else
+            for(auto& cover: tabular.minimumCovers())
+                eqs.push_back(tabular.ansToString(cover));
+        if(tabular.getStatus() != SOLVED) return "not solved";
+        set<vector<Cube>> distinct;
+        for(auto& eq: eqs){
+            shown = eq;
+            vector<Cube> cover;
+            string error = checkCover(pb.f, eq, n, pb.reference, true, &cover);
+            if(!error.empty()) return error;
+            sort(cover.begin(), cover.end());
+            if(!distinct.insert(cover).second) return "cover given twice";
+        }
+        if(eqs.size() != pb.minimumCovers)
+            return to_string(eqs.size()) + " minimum covers, reference " + to_string(pb.minimumCovers);
+        return "";
+    }
+    // MULTI: both outputs are covered, shared terms are counted once. Using the minimum covers of both outputs
+    // is a solution, and no output can do with less than its own minimum
+    MultiTabular multi(n, 2);
+    for(ull p = 0; p < pb.f.size(); ++p){
+        if(pb.f[p] == 1) multi.addMinterm(0, p);
+        if(pb.f[p] == 2) multi.addDontcare(0, p);
+        if(pb.g[p] == 1) multi.addMinterm(1, p);
+        if(pb.g[p] == 2) multi.addDontcare(1, p);
+    }
+    vector<string> eqs = multi.solve(engine.mode == APPROXIMATION);
+    if(eqs.size() != 2) return "expected 2 equations";
+    shown = eqs[0] + ", " + eqs[1];
+    vector<Cube> coverF, coverG;
+    if(!parseEquation(eqs[0], n, coverF) || !parseEquation(eqs[1], n, coverG))
+        return "malformed equation";
+    string error = verify(pb.f, coverF);
+    if(error.empty()) error = verify(pb.g, coverG);
+    if(!error.empty()) return error;
+    set<Cube> terms(coverF.begin(), coverF.end());
+    terms.insert(coverG.begin(), coverG.end());
+    int lower = max(pb.reference, pb.referenceG), upper = pb.reference + pb.referenceG;
+    if(pb.f == pb.g) upper = pb.reference;
+    if((int)terms.size() < lower)
+        return to_string(terms.size()) + " terms, below " + to_string(lower);
+    if(engine.exact && (int)terms.size() > upper)
+        return to_string(terms.size()) + " terms, above " + to_string(upper);
+    return "";
+}
+
+// Result of an engine in the large mode
+struct LargeResult{
+    const Engine* engine;
+    int cost;
+    bool timedOut;
+    SolveMode autoMode; // Weakest engine AUTO used on a part
+};
+
+string runLarge(const Engine& engine, const Problem& pb, long long timeLimit, long long watchdog, vector<LargeResult>& results, int& cancelled, string& shown){
+    // The solve is cancelled if it is still running after watchdog ms, which only the exact engines may need
+    Tabular tabular = build(engine, pb);
+    tabular.setDense(engine.dense);
+    tabular.setReduction(engine.reduction);
+    tabular.setTimeLimit(timeLimit);
+    shared_ptr<SolveControl> control = make_shared<SolveControl>();
+    future<string> result = tabular.solveAsync(engine.mode, control);
+    if(result.wait_for(chrono::milliseconds(watchdog)) != future_status::ready)
+        control->cancel();
+    shown = result.get();
+    if(tabular.getStatus() == CANCELLED){
+        if(engine.mode == AUTO || engine.mode == ANYTIME || engine.mode == APPROXIMATION) // Bounded by the time limit
+            return "cancelled, the time limit is " + to_string(timeLimit) + "ms";
+        ++cancelled;
+        return "";
+    }
+    if(tabular.getStatus() != SOLVED) return "not solved";
+    vector<Cube> cover;
+    string error = checkCover(pb.f, shown, pb.n, 0, false, &cover);
+    if(error.empty())
+        results.push_back({&engine, (int)cover.size(), tabular.getStats().timedOut, tabular.getStats().autoMode});
+    return error;
+}
+
+string crossCheck(const vector<LargeResult>& results){
+    // The exact engines that didn't time out agree on the minimum, and nothing is below it
+    int minimum = -1;
+    for(auto& r: results)
+        if(r.engine->exact && !r.timedOut && (minimum == -1 || r.cost < minimum))
+            minimum = r.cost;
+    for(auto& r: results){
+        if(minimum == -1) break;
+        if(r.cost < minimum)
+            return r.engine->name + ": cost " + to_string(r.cost) + " below the exact minimum " + to_string(minimum);
+        if(r.engine->exact && !r.timedOut && r.cost != minimum)
+            return r.engine->name + ": cost " + to_string(r.cost) + ", minimum " + to_string(minimum);
+    }
+    return "";
+}
+
+string checkChartCover(const vector<vector<int>>& GL, int numberOfMinterms, const vector<int>& cover, int cost){
+    vector<bool> covered(numberOfMinterms, false);
+    for(int p: cover)
+        for(int u: GL[p])
+            covered[u] = true;
+    if(count(covered.begin(), covered.end(), false))
+        return "misses a minterm of the chart";
+    if(cost >= 0 && (int)cover.size() != cost)
+        return "cover of " + to_string(cover.size()) + " PIs, minimum " + to_string(cost);
+    return "";
+}
+
+string runChart(mt19937_64& rng, int& numberOfMinterms, bool& skipped){
+    // A chart past one word of minterms and of PIs, given to the static searches directly: a few small cyclic
+    // cores, the other minterms in PIs of their own, and some PIs inside others as alternatives. Minterms and
+    // PIs are shuffled
+    int nR = 65 + rng() % 96, u = 0;
+    numberOfMinterms = nR;
+    vector<vector<int>> GL, GR(nR);
+    for(int c = 1 + rng() % 2; c > 0; --c){
+        int cols = 4 + rng() % 5, base = u;
+        u += cols;
+        vector<int> hits(cols, 0);
+        for(int r = cols + rng() % 4; r > 0; --r){
+            vector<int> row;
+            for(int k = 0; k < cols; ++k)
+                if(rng() % 5 < 2){
+                    row.push_back(base + k);
+                    ++hits[k];
+                }
+            if(!row.empty())
+                GL.push_back(row);
+        }
+        for(int k = 0; k < cols; ++k)
+            if(!hits[k])
+                GL.push_back({base + k, base + (k + 1) % cols});
+    }
+    int exclusive = GL.size();
+    while(u < nR){
+        vector<int> row;
+        for(int len = 1 + rng() % 2; len > 0 && u < nR; --len)
+            row.push_back(u++);
+        GL.push_back(row);
+    }
+    for(int k = rng() % 5; k > 0; --k){
+        vector<int> row;
+        for(int v: GL[exclusive + rng() % (GL.size() - exclusive)])
+            if(rng() % 3)
+                row.push_back(v);
+        if(!row.empty())
+            GL.push_back(row);
+    }
+    vector<int> place(nR);
+    iota(place.begin(), place.end(), 0);
+    shuffle(place.begin(), place.end(), rng);
+    shuffle(GL.begin(), GL.end(), rng);
+    for(int p = 0; p < (int)GL.size(); ++p){
+        for(int& v: GL[p])
+            v = place[v];
+        sort(GL[p].begin(), GL[p].end());
+        for(int v: GL[p])
+            GR[v].push_back(p);
+    }
+
+    // The bitset search, Petrick's method and the stream of covers have to agree on the minimum and the covers
+    SearchLimit exactLimit(2000), petrickLimit(2000);
+    vector<int> exactCase;
+    int cost = -1;
+    Tabular::bruteForce(GL, nR, exactCase, cost, NULL, &exactLimit);
+    vector<vector<int>> covers;
+    if(!exactLimit.expired)
+        Tabular::petrick(GL, GR, covers, NULL, &petrickLimit);
+    if(exactLimit.expired || petrickLimit.expired){
+        skipped = true;
+        return "";
+    }
+    string error = checkChartCover(GL, nR, exactCase, cost);
+    if(!error.empty()) return "bitset search: " + error;
+    set<vector<int>> distinct;
+    for(auto cover: covers){
+        error = checkChartCover(GL, nR, cover, cost);
+        if(!error.empty()) return "petrick: " + error;
+        sort(cover.begin(), cover.end());
+        if(!distinct.insert(cover).second) return "petrick: cover given twice";
+    }
+    vector<int> rev(GL.size()), fixed, cover;
+    iota(rev.begin(), rev.end(), 0);
+    CoverStream stream(GL, nR, rev, fixed, cost, covers.size() + 1);
+    size_t streamed = 0;
+    while(stream.next(cover)){
+        error = checkChartCover(GL, nR, cover, cost);
+        if(!error.empty()) return "minimum covers: " + error;
+        sort(cover.begin(), cover.end());
+        if(!distinct.count(cover)) return "minimum covers: cover unknown to petrick";
+        ++streamed;
+    }
+    if(streamed != covers.size())
+        return "petrick " + to_string(covers.size()) + " minimum covers, stream " + to_string(streamed);
+    vector<int> greedyCase;
+    Tabular::greedy(GL, GR, greedyCase);
+    error = checkChartCover(GL, nR, greedyCase, -1);
+    if(!error.empty()) return "greedy: " + error;
+    if((int)greedyCase.size() < cost) return "greedy below the minimum";
+    if(Tabular::minimumCost(GL, GR) != cost) return "minimumCost differs from the bitset search";
+    return "";
+}
+
+int main(int argc, char* argv[]){
+    int iterations = 2000, maxInputs = 6, largeIterations = 100, charts = 300;
+    long long timeLimit = 100, watchdog = 500;
+    ull seed = 1;
+    for(int i = 1; i < argc; ++i){
+        string arg = argv[i];
+        string next = i + 1 < argc ? argv[i + 1] : "";
+        if(arg == "--iterations") iterations = stoi(next), ++i;
+        else if(arg == "--seed") seed = stoull(next), ++i;
+        else if(arg == "--inputs") maxInputs = max(1, min(6, stoi(next))), ++i;
+        else if(arg == "--large") largeIterations = stoi(next), ++i;
+        else if(arg == "--charts") charts = stoi(next), ++i;
+        else if(arg == "--time-limit") timeLimit = stoll(next), ++i;
+        else if(arg == "--watchdog") watchdog = stoll(next), ++i;
+        else{
+            cerr << "usage: fuzz [--iterations n] [--seed n] [--inputs max 1..6] [--large n] [--charts n] [--time-limit ms] [--watchdog ms]" << endl;
+            return 1;
+        }
+    }
+
+    mt19937_64 rng(seed);
+    vector<Engine> list = engines();
+    ResultCache canonicalCache(256);
+    int failures = 0;
+    auto randomFunction = [&](int n, Function& f){
+        // Density and don't care ratio are random too, so that sparse and dense functions are both tried
+        ull size = 1ULL << n;
+        int onRate = rng() % 101, dcRate = rng() % 31;
+        f.assign(size, 0);
+        for(ull p = 0; p < size; ++p){
+            int r = rng() % 100;
+            if(r < dcRate) f[p] = 2;
+            else if(r < dcRate + onRate) f[p] = 1;
+        }
+    };
+    for(int it = 0; it < iterations; ++it){
+        Problem pb;
+        pb.n = 1 + rng() % maxInputs;
+        randomFunction(pb.n, pb.f);
+        for(ull p = 0; p < pb.f.size(); ++p){
+            if(pb.f[p] == 1) pb.minterms.push_back(p);
+            if(pb.f[p] == 2) pb.dontcares.push_back(p);
+        }
+        if(pb.minterms.empty()) // A function without ON points has no equation
+            continue;
+        // Duplicates and shuffled input go through preprocessing
+        if(rng() % 4 == 0)
+            pb.minterms.push_back(pb.minterms[rng() % pb.minterms.size()]);
+        shuffle(pb.minterms.begin(), pb.minterms.end(), rng);
+        splitIntoCubes(pb.f, pb.n, 1, rng, pb.onCubes);
+        splitIntoCubes(pb.f, pb.n, 2, rng, pb.dcCubes);
+        if(rng() % 2)
+            pb.g = pb.f;
+        else
+            do randomFunction(pb.n, pb.g); while(count(pb.g.begin(), pb.g.end(), 1) == 0);
+        pb.reference = referenceCost(pb.f, pb.n, &pb.minimumCovers);
+        pb.referenceG = referenceCost(pb.g, pb.n);
+
+        for(auto& engine: list){
+            if(engine.check == MULTI && engine.exact && pb.n > 5) // The multi-output exact search is too slow past 5 inputs
+                continue;
+            string shown, error = run(engine, pb, rng, canonicalCache, shown);
+            if(!error.empty()){
+                ++failures;
+                cout << "iteration " << it << ", " << engine.name << ": " << error << endl;
+                cout << "  " << pb.n << " inputs, minterms";
+                for(auto m: pb.minterms) cout << " " << m;
+                cout << ", don't cares";
+                for(auto d: pb.dontcares) cout << " " << d;
+                cout << endl << "  " << shown << endl;
+            }
+        }
+    }
+    cout << iterations << " functions, " << list.size() << " engines, " << failures << " failure(s)" << endl;
+    int total = failures;
+
+    // Large functions of 7 to 10 inputs: unions of random cubes with scattered points, which the exact engines
+    // mostly finish, or uniform random ones, which leave big cyclic parts for the memoized and anytime branches
+    vector<Engine> large = largeEngines();
+    int cancelled = 0, autoModes[AUTO] = {0};
+    failures = 0;
+    for(int it = 0; it < largeIterations; ++it){
+        Problem pb;
+        pb.n = 7 + rng() % 4;
+        ull size = 1ULL << pb.n;
+        pb.f.assign(size, 0);
+        int scattered = 20 + rng() % 31, dcRate = rng() % 31;
+        if(rng() % 2){
+            scattered = rng() % 20;
+            for(int c = 2 + rng() % 14; c > 0; --c){
+                ull ask = 0;
+                for(int dashes = 1 + rng() % (pb.n - 2); __builtin_popcountll(ask) < dashes; )
+                    ask |= 1ULL << (rng() % pb.n);
+                ull bits = rng() & (size - 1) & ~ask;
+                for(ull t = ask; ; t = (t - 1) & ask){
+                    pb.f[bits | t] = 1;
+                    if(!t) break;
+                }
+            }
+        }
+        for(ull p = 0; p < size; ++p){
+            int r = rng() % 100;
+            if(r < scattered) pb.f[p] = 1;
+            else if(r < scattered + dcRate) pb.f[p] = 2;
+        }
+        for(ull p = 0; p < size; ++p){
+            if(pb.f[p] == 1) pb.minterms.push_back(p);
+            if(pb.f[p] == 2) pb.dontcares.push_back(p);
+        }
+        if(pb.minterms.empty())
+            continue;
+        vector<LargeResult> results;
+        string error, shown;
+        bool hard = false; // Once an exact solve is cancelled, the other exact engines without a time limit are skipped
+        for(auto& engine: large){
+            bool limited = engine.mode == AUTO || engine.mode == ANYTIME || engine.mode == APPROXIMATION;
+            if(hard && !limited)
+                continue;
+            int before = cancelled;
+            error = runLarge(engine, pb, timeLimit, watchdog, results, cancelled, shown);
+            hard |= cancelled != before;
+            if(!error.empty()){
+                error = engine.name + ": " + error;
+                break;
+            }
+        }
+        if(error.empty())
+            error = crossCheck(results);
+        for(auto& r: results)
+            if(r.engine->mode == AUTO)
+                ++autoModes[r.autoMode];
+        if(!error.empty()){
+            ++failures;
+            cout << "large function " << it << ", " << error << endl;
+            cout << "  " << pb.n << " inputs, minterms";
+            for(auto m: pb.minterms) cout << " " << m;
+            cout << ", don't cares";
+            for(auto d: pb.dontcares) cout << " " << d;
+            cout << endl << "  " << shown << endl;
+        }
+    }
+    cout << largeIterations << " large functions, " << large.size() << " engines, " << failures << " failure(s), "
+         << cancelled << " exact solve(s) cancelled after " << watchdog << "ms" << endl;
+    cout << "  weakest engine of auto: exact " << autoModes[TRUE_SOLUTION] << ", memoized " << autoModes[MEMOIZED]
+         << ", anytime " << autoModes[ANYTIME] << ", greedy " << autoModes[APPROXIMATION] << endl;
+    total += failures;
+
+    // Charts past one word of minterms and PIs for the bitset search, Petrick's method and the stream of covers
+    int skipped = 0;
+    failures = 0;
+    for(int it = 0; it < charts; ++it){
+        int minterms;
+        bool skip = false;
+        string error = runChart(rng, minterms, skip);
+        skipped += skip;
+        if(!error.empty()){
+            ++failures;
+            cout << "chart " << it << " of " << minterms << " minterms: " << error << endl;
+        }
+    }
+    cout << charts << " charts of 65 to 160 minterms, " << failures << " failure(s), " << skipped << " skipped after 2000ms" << endl;
+    total += failures;
+    return total != 0;
+}
@@ -0,0 +1,105 @@
+/*
+
+title: Load generator for the local minimization server
+author: 윤상건 (Sang-geon Yun, ggj06281@kookmin.ac.kr)
+
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include "../headers/LocalServer.h"
+using namespace std;
+
+typedef unsigned long long int ull;
+typedef long long int lli;
+
+int main(int argc, char* argv[]){
+    string socketPath = "/tmp/tabular.sock", engine = "exact";
+    int clients = 4, requests = 1000, batchSize = 16, inputs = 8, minterms = 20, distinct = 100;
+    for(int i = 1; i < argc; ++i){
+        string arg = argv[i];
+        string next = i + 1 < argc ? argv[i + 1] : "";
+        if(arg == "--socket") socketPath = next, ++i;
+        else if(arg == "--engine") engine = next, ++i;
+        else if(arg == "--clients") clients = stoi(next), ++i;
+        else if(arg == "--requests") requests = stoi(next), ++i;
+        else if(arg == "--batch") batchSize = max(1, stoi(next)), ++i;
+        else if(arg == "--inputs") inputs = min(63, max(1, stoi(next))), ++i;
+        else if(arg == "--minterms") minterms = stoi(next), ++i;
+        else if(arg == "--distinct") distinct = max(1, stoi(next)), ++i;
+        else{
+            cerr << "usage: loadgen [--socket path] [--engine exact|dp|petrick|greedy|heuristic|anytime|auto] [--clients n] [--requests n per client]" << endl;
+            cerr << "               [--batch n] [--inputs n] [--minterms n] [--distinct n functions]" << endl;
+            return 1;
+        }
+    }
+
+    // Requests are drawn from a fixed set of functions, so repeated ones can hit the server caches
+    vector<MinimizeRequest> functions(distinct);
+    mt19937_64 rng(1);
+    for(int f = 0; f < distinct; ++f){
+        functions[f].engine = engine;
+        functions[f].numberOfInputs = inputs;
+        for(int i = 0; i < minterms; ++i)
+            functions[f].minterms.push_back(rng() % (1ULL << inputs));
+    }
+
+    vector<vector<lli>> latency(clients);
+    vector<int> failures(clients, 0);
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    vector<thread> threads;
+    for(int c = 0; c < clients; ++c){
+        threads.push_back(thread([&, c](){
+            LocalClient client;
+            if(!client.connect(socketPath)){
+                failures[c] = requests;
+                return;
+            }
+            mt19937 pick(c);
+            for(int sent = 0; sent < requests; sent += batchSize){
+                vector<MinimizeRequest> batch;
+                for(int k = sent; k < min(requests, sent + batchSize); ++k){
+                    batch.push_back(functions[pick() % distinct]);
+                    batch.back().id = k;
+                }
+                chrono::steady_clock::time_point start = chrono::steady_clock::now();
+                if(!client.send(batch)){
+                    failures[c] += requests - sent;
+                    return;
+                }
+                MinimizeResult result;
+                for(int k = 0; k < batch.size(); ++k){
+                    if(!client.receive(result)){
+                        failures[c] += requests - sent;
+                        return;
+                    }
+                    if(!result.ok) ++failures[c];
+                    latency[c].push_back(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+                }
+            }
+        }));
+    }
+    for(auto& t: threads)
+        t.join();
+    double wall = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - begin).count() / 1e9;
+
+    vector<lli> all;
+    int failed = 0;
+    for(int c = 0; c < clients; ++c){
+        all.insert(all.end(), latency[c].begin(), latency[c].end());
+        failed += failures[c];
+    }
+    sort(all.begin(), all.end());
+    auto percentile = [&](double p){
+        return all.empty() ? 0 : all[min(all.size() - 1, (size_t)(p * all.size()))] / 1000;
+    };
+    cout << all.size() << " results, " << failed << " failed, " << wall << "s, " << (wall > 0 ? all.size() / wall : 0) << " problems/s" << endl;
+    cout << "latency (us): p50 " << percentile(0.5) << ", p90 " << percentile(0.9) << ", p99 " << percentile(0.99)
+        << ", max " << (all.empty() ? 0 : all.back() / 1000) << endl;
+    return failed != 0;
+}